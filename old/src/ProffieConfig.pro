@@ -56,18 +56,28 @@ SOURCES += \
     config/settings.cpp \
     log/logger.cpp \
     pconf/pconf.cpp \
-    proffieconstructs/utilfuncs.cpp \
+    prop/propcache.cpp \
     prop/propfile.cpp \
+    proffieconstructs/random.cpp \
     proffieconstructs/range.cpp \
     proffieconstructs/vector3d.cpp \
     stylepreview/blade.cpp \
+    stylepreview/multirenderer.cpp \
+    stylepreview/profiler.cpp \
+    stylepreview/renderer.cpp \
     styleeditor/styleeditor.cpp \
     styleeditor/blocks/bitsctrl.cpp \
     styleeditor/blocks/styleblock.cpp \
     stylemanager/stylemanager.cpp \
     styles/bladestyle.cpp \
+    styles/bytecode.cpp \
     styles/parse.cpp \
+    styles/variance.cpp \
     styles/colordata.cpp \
+    styles/colorkernels.cpp \
+    styles/ledframe.cpp \
+    styles/intern.cpp \
+    styles/stylepool.cpp \
     styles/elements/args.cpp \
     styles/elements/builtin.cpp \
     styles/elements/colors.cpp \
@@ -81,6 +91,8 @@ SOURCES += \
     styles/elements/wrappers.cpp \
     styles/documentation/styledocs.cpp \
     test/uitest.cpp \
+    utility/mappedfile.cpp \
+    utility/savefile.cpp \
     utility/time.cpp \
     ui/bool.cpp \
     ui/combobox.cpp \
@@ -102,17 +114,28 @@ HEADERS += \
     config/settings.h \
     log/logger.h \
     pconf/pconf.h \
+    prop/propcache.h \
     prop/propfile.h \
+    proffieconstructs/random.h \
     proffieconstructs/range.h \
     proffieconstructs/utilfuncs.h \
     proffieconstructs/vector3d.h \
     stylepreview/blade.h \
+    stylepreview/multirenderer.h \
+    stylepreview/profiler.h \
+    stylepreview/renderer.h \
     styleeditor/styleeditor.h \
     styleeditor/blocks/styleblock.h \
     stylemanager/stylemanager.h \
     styles/parse.h \
+    styles/variance.h \
     styles/bladestyle.h \
+    styles/bytecode.h \
     styles/colordata.h \
+    styles/colorkernels.h \
+    styles/ledframe.h \
+    styles/intern.h \
+    styles/stylepool.h \
     styles/elements/args.h \
     styles/elements/builtin.h \
     styles/elements/colors.h \
@@ -126,6 +149,9 @@ HEADERS += \
     styles/elements/wrappers.h \
     styles/documentation/styledocs.h \
     test/uitest.h \
+    utility/mappedfile.h \
+    utility/savefile.h \
+    utility/spscqueue.h \
     utility/time.h \
     ui/bool.h \
     ui/combobox.h \
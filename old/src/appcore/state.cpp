@@ -50,18 +50,15 @@ void AppCore::init() {
         return;
     }
 
-    PConf::Section* section{nullptr};
-    while (!stateFile.eof()) {
-        section = PConf::readSection(stateFile);
-        if (!section) continue;
-
-        if (section->name == "FIRSTRUN") {
-            firstRun = section->value.value_or("TRUE") == "TRUE";
-        } else if (section->name == "PROPS") {
-            for (const auto& entry : section->entries) if (entry->label) propFiles->push_back(entry->label.value());
-        } else if (section->name == "CONFIGS") {
-            for (const auto& entry : section->entries) if (entry->label) configFiles->push_back(entry->label.value());
-        }
+    auto state{PConf::Document::read(stateFile)};
+    if (const auto *firstRunEntry{state.find(PConf::Key::FIRSTRUN)}) {
+        firstRun = firstRunEntry->value.value_or("TRUE") == "TRUE";
+    }
+    if (const auto *props{state.find(PConf::Key::PROPS)}) {
+        for (const auto& prop : props->entries) if (prop.label) propFiles->emplace_back(prop.label.value());
+    }
+    if (const auto *configs{state.find(PConf::Key::CONFIGS)}) {
+        for (const auto& config : configs->entries) if (config.label) configFiles->emplace_back(config.label.value());
     }
 
     (*propData) = PropFile::getPropData(*propFiles);
@@ -0,0 +1,21 @@
+# Color kernel benchmark, comparing LedFrame operations against the
+# per-LED ColorData path they replace.
+#
+# Build and run from a separate build directory:
+#   qmake path/to/src/benchmark/benchmark.pro && make && ./kernelbench
+
+TEMPLATE = app
+TARGET = kernelbench
+CONFIG += c++20 console release
+CONFIG -= qt app_bundle
+
+QMAKE_CXXFLAGS += $$system(wx-config --cxxflags)
+LIBS += $$system(wx-config --libs)
+
+INCLUDEPATH += ..
+
+SOURCES += \
+    kernels.cpp \
+    ../styles/colordata.cpp \
+    ../styles/colorkernels.cpp \
+    ../styles/ledframe.cpp \
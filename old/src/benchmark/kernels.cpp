@@ -0,0 +1,129 @@
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * benchmark/kernels.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "styles/colordata.h"
+#include "styles/ledframe.h"
+
+using namespace BladeStyles;
+
+namespace {
+
+constexpr int32_t ITERATIONS{100000};
+constexpr int32_t MIX_SHIFT{14};
+constexpr int32_t ALPHA_SHIFT{15};
+constexpr uint32_t ALPHA_MAX{1 << ALPHA_SHIFT};
+
+// Summed from every result, so the work can't be optimized away.
+uint64_t checksum{0};
+
+/**
+ * @return average nanoseconds per call of func
+ */
+template<class FUNC>
+double measure(FUNC&& func) {
+    const auto start{std::chrono::steady_clock::now()};
+    for (int32_t iteration{0}; iteration < ITERATIONS; iteration++) func(iteration);
+    const auto elapsed{std::chrono::steady_clock::now() - start};
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / ITERATIONS;
+}
+
+void report(const char* name, int32_t numLeds, double scalarNanos, double frameNanos) {
+    std::printf(
+        "%-18s %4d LEDs   per-LED %9.1f ns   LedFrame %9.1f ns   %5.1fx\n",
+        name, numLeds, scalarNanos, frameNanos, scalarNanos / frameNanos
+    );
+}
+
+void run(int32_t numLeds) {
+    std::mt19937 rng{static_cast<uint32_t>(numLeds)};
+    std::uniform_int_distribution<uint32_t> channel{0, ALPHA_MAX};
+    std::uniform_int_distribution<uint32_t> weight{0, 1 << MIX_SHIFT};
+
+    std::vector<ColorData> colorsA(numLeds);
+    std::vector<ColorData> colorsB(numLeds);
+    std::vector<ColorData> colorsOut(numLeds);
+    std::vector<uint32_t> weights(numLeds);
+    for (int32_t led{0}; led < numLeds; led++) {
+        colorsA[led] = { channel(rng), channel(rng), channel(rng), channel(rng) };
+        colorsB[led] = { channel(rng), channel(rng), channel(rng), channel(rng) };
+        weights[led] = weight(rng);
+    }
+
+    LedFrame frameA{numLeds};
+    LedFrame frameB{numLeds};
+    LedFrame frameOut{numLeds};
+    frameA.setColors(colorsA);
+    frameB.setColors(colorsB);
+
+    // What TrFadeX does
+    const auto scalarFade{measure([&](int32_t iteration) {
+        const auto fade{static_cast<int32_t>(iteration & ((1 << MIX_SHIFT) - 1))};
+        for (int32_t led{0}; led < numLeds; led++) colorsOut[led] = mixColors(colorsA[led], colorsB[led], fade, MIX_SHIFT);
+        checksum += colorsOut[iteration % numLeds].red;
+    })};
+    const auto frameFade{measure([&](int32_t iteration) {
+        const auto fade{static_cast<uint32_t>(iteration & ((1 << MIX_SHIFT) - 1))};
+        frameOut.mix(frameA, frameB, fade, MIX_SHIFT);
+        checksum += frameOut.red()[iteration % numLeds];
+    })};
+    report("mix (one weight)", numLeds, scalarFade, frameFade);
+
+    // What TrWipeX and friends do
+    const auto scalarWeights{measure([&](int32_t iteration) {
+        for (int32_t led{0}; led < numLeds; led++) colorsOut[led] = mixColors(colorsA[led], colorsB[led], static_cast<int32_t>(weights[led]), MIX_SHIFT);
+        checksum += colorsOut[iteration % numLeds].red;
+    })};
+    const auto frameWeights{measure([&](int32_t iteration) {
+        frameOut.mix(frameA, frameB, weights, MIX_SHIFT);
+        checksum += frameOut.red()[iteration % numLeds];
+    })};
+    report("mix (per-LED)", numLeds, scalarWeights, frameWeights);
+
+    // A layer painted over a base color
+    const auto scalarPaint{measure([&](int32_t iteration) {
+        for (int32_t led{0}; led < numLeds; led++) {
+            const auto& base{colorsA[led]};
+            const auto& layer{colorsB[led]};
+            auto& out{colorsOut[led]};
+            out = mixColors(base, layer, static_cast<int32_t>(layer.alpha), ALPHA_SHIFT);
+            out.alpha = base.alpha + (((ALPHA_MAX - base.alpha) * layer.alpha) >> ALPHA_SHIFT);
+        }
+        checksum += colorsOut[iteration % numLeds].red;
+    })};
+    const auto framePaint{measure([&](int32_t iteration) {
+        frameOut.paintOver(frameB);
+        checksum += frameOut.red()[iteration % numLeds];
+    })};
+    report("paintOver", numLeds, scalarPaint, framePaint);
+}
+
+} // namespace
+
+int main() {
+    for (const auto numLeds : { 144, 288 }) run(numLeds);
+    std::printf("(checksum %llu)\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
@@ -213,9 +213,11 @@ static void readTop(std::istream& stream, Config::Data& config) {
         switch (define.value()->second->getType()) {
         case SettingType::TOGGLE:
             static_cast<Toggle<DefineBase>*>(define.value()->second)->value = true;
+            updateDependents(*define.value()->second);
             break;
         case SettingType::SELECTION:
             static_cast<Selection<DefineBase>*>(define.value()->second)->value = true;
+            updateDependents(*define.value()->second);
             break;
         case SettingType::NUMERIC: {
             auto *castDef{static_cast<Numeric<DefineBase>*>(define.value()->second)};
@@ -290,27 +292,27 @@ static void writeTop(std::ostream& stream, Config::Data& config) {
         switch (define.getType()) {
         case SettingType::TOGGLE: {
             auto *castDef{static_cast<Toggle<DefineBase>*>(&define)};
-            if (castDef->value && !castDef->isDisabled()) stream << "#define " << castDef->define << castDef->postfix << std::endl;
+            if (castDef->value && !castDef->disabled) stream << "#define " << castDef->define << castDef->postfix << std::endl;
             break;
         }
         case SettingType::SELECTION: {
             auto *castDef{static_cast<Selection<DefineBase>*>(&define)};
-            if (castDef->value && !castDef->isDisabled()) stream << "#define " << castDef->define << castDef->postfix << std::endl;
+            if (castDef->value && !castDef->disabled) stream << "#define " << castDef->define << castDef->postfix << std::endl;
             break;
         }
         case SettingType::NUMERIC: {
             auto *castDef{static_cast<Numeric<DefineBase>*>(&define)};
-            if (!castDef->isDisabled()) stream << "#define " << castDef->define << " " << castDef->value << castDef->postfix << std::endl;
+            if (!castDef->disabled) stream << "#define " << castDef->define << " " << castDef->value << castDef->postfix << std::endl;
             break;
         }
         case SettingType::DECIMAL: {
             auto *castDef{static_cast<Decimal<DefineBase>*>(&define)};
-            if (!castDef->isDisabled()) stream << "#define " << castDef->define << " " << castDef->value << castDef->postfix << std::endl;
+            if (!castDef->disabled) stream << "#define " << castDef->define << " " << castDef->value << castDef->postfix << std::endl;
             break;
         }
         case SettingType::COMBO: {
             auto *castDef{static_cast<Combo<DefineBase>*>(&define)};
-            if (!castDef->isDisabled()) stream << "#define " << castDef->define << " " << castDef->value << castDef->postfix << std::endl;
+            if (!castDef->disabled) stream << "#define " << castDef->define << " " << castDef->value << castDef->postfix << std::endl;
             break;
         }
         }
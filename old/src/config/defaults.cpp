@@ -74,7 +74,6 @@ static void initializePropDefines(Config::PropMap& propDefines) {
 static void initializeGeneralDefines(Config::Setting::DefineMap& generalDefines) {
 #	define DEFINE(type, ...) { \
         auto entry{new type<Config::Setting::DefineBase>}; \
-        entry->group = generalDefines; \
         __VA_ARGS__ \
         generalDefines.emplace(entry->define, entry); \
     }
@@ -192,4 +191,6 @@ static void initializeGeneralDefines(Config::Setting::DefineMap& generalDefines)
            )
 
 #	undef DEFINE
+
+    linkDependencies(generalDefines);
 }
@@ -19,34 +19,75 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+static bool isToggle(const Config::Setting::DefineBase& setting);
+
 bool Config::Setting::DefineBase::isDisabled() {
-    bool hasRequired{!requireAny};
-    for (const auto& reqName : require) {
-        auto req{group.find(reqName)};
-        if (req == group.end() && !requireAny) {
-            hasRequired = false;
-            break;
+    if (missingRequirement) return true;
+
+    for (const auto *disabler : disabledBy) {
+        if (!disabler->value) return true;
+    }
+
+    if (requireAny) {
+        for (const auto *req : required) {
+            if (req->value) return false;
         }
+        return true;
+    }
 
-        if (req->second->getType() != SettingType::TOGGLE && req->second->getType() != SettingType::SELECTION) continue;
-        auto *castReq{static_cast<Toggle<DefineBase>*>(req->second)};
+    for (const auto *req : required) {
+        if (!req->value) return true;
+    }
+    return false;
+}
 
-        if (requireAny && castReq->value) {
-            hasRequired = true;
-            break;
+void Config::Setting::linkDependencies(const DefineMap& defines) {
+    for (const auto& [ _, setting ] : defines) {
+        setting->required.clear();
+        setting->disabledBy.clear();
+        setting->dependents.clear();
+        setting->missingRequirement = false;
+    }
+
+    for (const auto& [ _, setting ] : defines) {
+        for (const auto& reqName : setting->require) {
+            const auto req{defines.find(reqName)};
+            if (req == defines.end()) {
+                if (!setting->requireAny) setting->missingRequirement = true;
+                continue;
+            }
+            // Only toggles get an edge. Anything else never disables a
+            // require-all setting, but never counts for a requireAny one.
+            if (!isToggle(*req->second)) continue;
+
+            setting->required.push_back(static_cast<Toggle<DefineBase>*>(req->second));
+            req->second->dependents.push_back(setting);
+        }
+
+        if (!isToggle(*setting)) continue;
+        auto *disabler{static_cast<Toggle<DefineBase>*>(setting)};
+        for (const auto& disableName : disabler->disable) {
+            const auto target{defines.find(disableName)};
+            if (target == defines.end()) continue;
+
+            target->second->disabledBy.push_back(disabler);
+            disabler->dependents.push_back(target->second);
         }
-        if (!requireAny) hasRequired &= castReq->value;
     }
 
-    bool disabled{false};
-    for (const auto& [ _, disabler ] : group) {
-        if (disabler->getType() != SettingType::TOGGLE && disabler->getType() != SettingType::SELECTION) continue;
+    for (const auto& [ _, setting ] : defines) setting->disabled = setting->isDisabled();
+}
 
-        auto *castDis{static_cast<Toggle<DefineBase>*>(disabler)};
-        if (castDis->disable.find(define) == castDis->disable.end()) continue;
+void Config::Setting::updateDependents(const DefineBase& changed, std::unordered_set<DefineBase*>* dirty) {
+    for (auto *dependent : changed.dependents) {
+        const auto disabled{dependent->isDisabled()};
+        if (disabled == dependent->disabled) continue;
 
-        disabled |= !castDis->value;
+        dependent->disabled = disabled;
+        if (dirty) dirty->insert(dependent);
     }
+}
 
-    return !hasRequired || disabled;
+static bool isToggle(const Config::Setting::DefineBase& setting) {
+    return setting.getType() == Config::Setting::SettingType::TOGGLE || setting.getType() == Config::Setting::SettingType::SELECTION;
 }
@@ -24,6 +24,7 @@
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "ui/combobox.h"
 #include "ui/numeric.h"
@@ -72,14 +73,34 @@ struct DefineBase : SettingBase {
     std::string postfix;
     bool pureDef{true};
 
-    DefineMap group;
     std::unordered_set<std::string> require;
     bool requireAny{false};
 
+    // Dependency graph, filled by linkDependencies()
+    std::vector<Toggle<DefineBase>*> required;
+    std::vector<Toggle<DefineBase>*> disabledBy;
+    std::vector<DefineBase*> dependents;
+    bool missingRequirement{false};
+    // Cached result of isDisabled(), kept current by updateDependents(),
+    // which has to be called whenever a toggle or selection value is set.
+    bool disabled{false};
+
     SettingType getType() const override = 0;
     virtual bool isDisabled();
 };
 
+/**
+ * Resolve the require/disable names of every setting in defines into
+ * graph edges. Must be called once the map is fully populated.
+ */
+void linkDependencies(const DefineMap& defines);
+/**
+ * Re-evaluate only the settings which depend on changed (after its value
+ * was modified), adding any whose enabled state flipped to dirty, if given,
+ * so only those need refreshing in the UI.
+ */
+void updateDependents(const DefineBase& changed, std::unordered_set<DefineBase*>* dirty = nullptr);
+
 
 template<class BASE>
 struct Toggle : BASE {
@@ -20,12 +20,15 @@
  */
 
 #include <iostream>
+#include <mutex>
 #include <ostream>
 #include <unordered_map>
 
 namespace Logger {
 
 std::unordered_map<std::ostream*, LogLevel>* logOutputs;
+// Messages may come from worker threads (e.g. prop loading)
+std::mutex logMutex;
 
 void init() {
     if (!logOutputs) logOutputs = new std::unordered_map<std::ostream*, LogLevel>{ {&std::cout, LogLevel::ALL} };
@@ -54,6 +57,7 @@ void log(LogLevel level, const std::string& message, const bool) {
         return;
     }
 
+    std::scoped_lock lock{logMutex};
     for (auto logOut : *logOutputs) {
         if (!(level & logOut.second)) continue;
         (*logOut.first) << prefix << message << "\e[0m\n";
@@ -62,10 +66,12 @@ void log(LogLevel level, const std::string& message, const bool) {
 }
 
 void addLogOut(std::ostream& out, LogLevel level) {
+    std::scoped_lock lock{logMutex};
     logOutputs->insert({ &out, level});
 }
 
 void removeLogOut(std::ostream& out) {
+    std::scoped_lock lock{logMutex};
     auto toRemove{logOutputs->find(&out)};
     if (toRemove != logOutputs->end()) logOutputs->erase(toRemove);
 }
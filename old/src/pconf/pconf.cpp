@@ -20,111 +20,246 @@
  */
 
 #include <algorithm>
-#include <istream>
-#include <ostream>
-#include <sstream>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <iterator>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include "log/logger.h"
+#include "utility/savefile.h"
 
-static std::optional<std::string> parseName(const std::string& line);
-static std::optional<std::string> parseValue(const std::string& line, std::istream& inStream);
-static std::optional<std::string> parseMultilineValue(std::istream& inStream);
-static std::optional<std::string> parseSinglelineValue(const std::string& lineEnd);
-static std::optional<std::string> parseLabel(const std::string& line);
-static std::optional<int32_t> parseLabelNum(const std::string& line);
+struct PConf::Document::Storage {
+    explicit Storage(std::string&& buffer) :
+        buffer(std::move(buffer)),
+        // Entries for a typical pconf end up taking about twice the size of the text
+        arena(this->buffer.size() * 2 + 1024) {}
 
-PConf::Entry* PConf::readEntry(std::istream& inStream, bool& isSect) {
-    isSect = false;
-    std::string line;
-    std::streampos prevLinePos{inStream.tellg()};
-    if (!std::getline(inStream, line)) return nullptr;
+    std::string buffer;
+    std::pmr::monotonic_buffer_resource arena;
+};
 
-    auto numOpenBraces{std::count(line.begin(), line.end(), '{')};
-    auto numCloseBraces{std::count(line.begin(), line.end(), '}')};
-    auto openBracePos{line.find('{')};
-    auto closeBracePos{line.find('}')};
-    auto hasSeperator{line.find(':') != std::string::npos};
-
-    isSect = (numOpenBraces - numCloseBraces == 1) && (openBracePos <= closeBracePos) && !hasSeperator;
-    if (isSect) {
-        inStream.seekg(prevLinePos);
-        return nullptr;
-    }
-
-    auto name{parseName(line)};
-    if (!name) return nullptr;
+/**
+ * Forward-only line cursor over the whole file.
+ *
+ * Lines are handed out as views into the buffer, and once handed out
+ * are never revisited, so the file is read in a single linear pass.
+ */
+struct LineReader {
+    std::string_view buffer;
+    size_t pos{0};
 
-    auto *ret{new Entry};
-    ret->name = name.value();
-    ret->value = parseValue(line, inStream);
-    ret->label = parseLabel(line);
-    ret->labelNum = parseLabelNum(line);
+    std::optional<std::string_view> nextLine();
+};
 
-    return ret;
+/**
+ * State for building a Document.
+ *
+ * Children are collected per-depth in reusable scratch vectors, then
+ * copied as one contiguous block into the arena when their section
+ * closes.
+ */
+struct DocumentReader {
+    LineReader lines;
+    std::pmr::memory_resource& arena;
+    std::vector<std::vector<PConf::Entry>> levels;
+    /**
+     * Scratch for values which can't be a plain view of the file
+     * (multi-line or comma-separated)
+     */
+    std::string valueBuf;
+
+    std::string_view store(std::string_view);
+    /**
+     * Store children into section, and build its key index
+     */
+    void store(PConf::Entry& section, const std::vector<PConf::Entry>&);
+};
+
+static std::string_view trim(std::string_view);
+static std::optional<std::string_view> parseName(std::string_view line);
+static std::optional<std::string_view> parseValue(std::string_view line, DocumentReader& reader);
+static std::optional<std::string_view> parseMultilineValue(DocumentReader& reader);
+static std::optional<std::string_view> parseSinglelineValue(std::string_view lineEnd, DocumentReader& reader);
+static std::optional<std::string_view> parseLabel(std::string_view line);
+static std::optional<int32_t> parseLabelNum(std::string_view line);
+
+PConf::Document::Document() = default;
+PConf::Document::Document(Document&&) noexcept = default;
+PConf::Document& PConf::Document::operator=(Document&&) noexcept = default;
+PConf::Document::~Document() = default;
+
+PConf::Document PConf::Document::read(std::istream& inStream) {
+    return read(std::string{std::istreambuf_iterator<char>(inStream), std::istreambuf_iterator<char>()});
 }
 
-PConf::Section* PConf::readSection(std::istream& inStream) {
-    std::string line;
-    if (!getline(inStream, line)) return nullptr;
-
-    auto name{parseName(line)};
-    if (!name) return nullptr;
-
-    auto *sect{new Section};
-    sect->name = name.value();
-    sect->label = parseLabel(line);
-    sect->labelNum = parseLabelNum(line);
-
-    bool foundSect{false};
-    while (inStream.peek() != EOF) {
-        auto *entry{readEntry(inStream, foundSect)};
-        if (foundSect) {
-            auto *subSect{readSection(inStream)};
-            if (!subSect) continue;
-            sect->entries.push_back(subSect);
+PConf::Document PConf::Document::read(std::string buffer) {
+    Document doc;
+    doc.mStorage = std::make_unique<Storage>(std::move(buffer));
+
+    DocumentReader reader{
+        .lines{ .buffer = doc.mStorage->buffer },
+        .arena = doc.mStorage->arena,
+        .levels = std::vector<std::vector<Entry>>(1),
+        .valueBuf{},
+    };
+    size_t depth{0};
+
+    const auto closeSection{[&reader, &depth]() {
+        auto& children{reader.levels[depth]};
+        reader.store(reader.levels[depth - 1].back(), children);
+        children.clear();
+        depth--;
+    }};
+
+    while (auto rawLine{reader.lines.nextLine()}) {
+        auto line{trim(*rawLine)};
+        if (line.empty()) continue;
+
+        if (line.front() == '}') {
+            if (depth == 0) Logger::warn("Stray closing brace, likely a formatting issue!", false);
+            else closeSection();
             continue;
         }
-        if (!entry) {
-            // Check for section end
-            char checkBuf{'\0'};
-            inStream.unget(); // \n
-            while ((checkBuf != '\n' && checkBuf != '}') && checkBuf != EOF) {
-                inStream.unget();
-                checkBuf = static_cast<char>(inStream.peek());
-            } 
-            inStream.get(); // \n
-            getline(inStream, line); // ungot line
-
-            if (checkBuf == '}') return sect;
-            continue;
+
+        auto numOpenBraces{std::count(line.begin(), line.end(), '{')};
+        auto numCloseBraces{std::count(line.begin(), line.end(), '}')};
+        auto openBracePos{line.find('{')};
+        auto closeBracePos{line.find('}')};
+        auto hasSeperator{line.find(':') != std::string_view::npos};
+
+        auto name{parseName(line)};
+        if (!name) continue;
+
+        auto isSect{(numOpenBraces - numCloseBraces == 1) && (openBracePos <= closeBracePos) && !hasSeperator};
+        Entry entry{
+            .name = *name,
+            .key = internKey(*name),
+            .value = isSect ? std::nullopt : parseValue(line, reader),
+            .label = parseLabel(line),
+            .labelNum = parseLabelNum(line),
+            .type = isSect ? DataType::SECTION : DataType::ENTRY,
+        };
+        reader.levels[depth].push_back(entry);
+
+        if (isSect) {
+            depth++;
+            if (reader.levels.size() == depth) reader.levels.emplace_back();
         }
-        sect->entries.push_back(entry);
     }
 
-    return sect;
+    if (depth != 0) {
+        Logger::warn("Reached end of file before section closed, likely a formatting issue!", false);
+        while (depth != 0) closeSection();
+    }
+
+    reader.store(doc.mRoot, reader.levels[0]);
+    return doc;
+}
+
+PConf::Key PConf::internKey(std::string_view name) {
+    static const std::unordered_map<std::string_view, Key> keyMap{
+#       define KMAP(enum, str) { str, Key::enum },
+
+        ALL_KEYS
+
+#       undef KMAP
+    };
+
+    const auto keyIt{keyMap.find(name)};
+    return keyIt == keyMap.end() ? Key::UNKNOWN : keyIt->second;
 }
 
-std::unordered_set<std::string> PConf::setFromValue(const std::optional<std::string>& value) {
+const PConf::Entry* PConf::Entry::find(Key findKey) const {
+    const auto keyBit{uint64_t{1} << static_cast<uint32_t>(findKey)};
+    if (findKey == Key::UNKNOWN || !(keyMask & keyBit)) return nullptr;
+
+    return &entries[keyIndex[std::popcount(keyMask & (keyBit - 1))]];
+}
+
+std::optional<std::string_view> LineReader::nextLine() {
+    if (pos >= buffer.length()) return std::nullopt;
+
+    auto lineEnd{buffer.find('\n', pos)};
+    if (lineEnd == std::string_view::npos) lineEnd = buffer.length();
+
+    auto line{buffer.substr(pos, lineEnd - pos)};
+    pos = lineEnd + 1;
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+    return line;
+}
+
+std::string_view DocumentReader::store(std::string_view str) {
+    if (str.empty()) return {};
+
+    auto *mem{static_cast<char*>(arena.allocate(str.length(), alignof(char)))};
+    std::memcpy(mem, str.data(), str.length());
+    return { mem, str.length() };
+}
+
+void DocumentReader::store(PConf::Entry& section, const std::vector<PConf::Entry>& entries) {
+    constexpr uint32_t NUM_KEYS{1
+#       define KMAP(enum, str) + 1
+        ALL_KEYS
+#       undef KMAP
+    };
+    static_assert(NUM_KEYS <= 64, "Keys must fit in keyMask");
+    if (entries.empty()) return;
+
+    auto *mem{static_cast<PConf::Entry*>(arena.allocate(entries.size() * sizeof(PConf::Entry), alignof(PConf::Entry)))};
+    std::uninitialized_copy(entries.begin(), entries.end(), mem);
+    section.entries = { mem, entries.size() };
+
+    uint64_t keyMask{0};
+    for (const auto& entry : entries) {
+        if (entry.key != PConf::Key::UNKNOWN) keyMask |= uint64_t{1} << static_cast<uint32_t>(entry.key);
+    }
+    if (!keyMask) return;
+
+    auto *keyIndex{static_cast<uint16_t*>(arena.allocate(std::popcount(keyMask) * sizeof(uint16_t), alignof(uint16_t)))};
+    // Walk backwards so the first entry for each key is what's left
+    for (auto idx{entries.size()}; idx-- > 0;) {
+        const auto key{static_cast<uint32_t>(entries[idx].key)};
+        if (!key) continue;
+        keyIndex[std::popcount(keyMask & ((uint64_t{1} << key) - 1))] = static_cast<uint16_t>(idx);
+    }
+
+    section.keyMask = keyMask;
+    section.keyIndex = keyIndex;
+}
+
+std::unordered_set<std::string> PConf::setFromValue(const std::optional<std::string_view>& value) {
     std::unordered_set<std::string> ret;
     size_t startPos{0};
     size_t endPos{0};
-    const std::string& val{value.value_or("")};
-    while (endPos != std::string::npos) {
+    const auto val{value.value_or("")};
+    while (endPos != std::string_view::npos) {
         endPos = val.find('\n', startPos);
-        ret.emplace(val.substr(startPos, endPos));
+        ret.emplace(val.substr(startPos, endPos == std::string_view::npos ? endPos : endPos - startPos));
         startPos = endPos + 1;
     } 
 
     return ret;
 }
 
-static std::optional<std::string> parseName(const std::string& line) {
+static std::string_view trim(std::string_view str) {
+    auto begin{str.find_first_not_of(" \t")};
+    if (begin == std::string_view::npos) return {};
+    auto end{str.find_last_not_of(" \t")};
+    return str.substr(begin, end - begin + 1);
+}
+
+static std::optional<std::string_view> parseName(std::string_view line) {
     auto bracePos{line.find('{')};
     auto parenPos{line.find('(')};
     auto seperatorPos{line.find(':')};
 
-    if (bracePos == std::string::npos && parenPos == std::string::npos && seperatorPos == std::string::npos) return std::nullopt;
+    if (bracePos == std::string_view::npos && parenPos == std::string_view::npos && seperatorPos == std::string_view::npos) return std::nullopt;
 
     auto nameBegin{line.find_first_not_of(" \t")};
     auto spacePos{line.find_first_of(" \t{(", nameBegin)};
@@ -132,81 +267,97 @@ static std::optional<std::string> parseName(const std::string& line) {
     return line.substr(nameBegin, nameEnd - nameBegin);
 }
 
-static std::optional<std::string> parseValue(const std::string& line, std::istream& inStream) {
+static std::optional<std::string_view> parseValue(std::string_view line, DocumentReader& reader) {
     auto seperatorPos{line.find(':')};
-    bool hasSeperator{seperatorPos != std::string::npos};
+    bool hasSeperator{seperatorPos != std::string_view::npos};
 
     if (!hasSeperator) return std::nullopt;
 
     auto bracePos{line.find('{')};
-    auto isMultiline{bracePos != std::string::npos && seperatorPos < bracePos};
-    if (isMultiline) return parseMultilineValue(inStream);
+    auto isMultiline{bracePos != std::string_view::npos && seperatorPos < bracePos};
+    if (isMultiline) return parseMultilineValue(reader);
 
-    return parseSinglelineValue(line.substr(seperatorPos + 1));
+    return parseSinglelineValue(line.substr(seperatorPos + 1), reader);
 }
 
-static std::optional<std::string> parseSinglelineValue(const std::string& lineEnd) {
-    std::istringstream lineStream(lineEnd);
+static std::optional<std::string_view> parseSinglelineValue(std::string_view lineEnd, DocumentReader& reader) {
+    bool usesQuotes{lineEnd.find('"') != std::string_view::npos};
 
-    bool usesQuotes{lineEnd.find('"') != std::string::npos};
-    bool record{false};
-
-    char buf{'\0'};
-    std::string ret;
-
-    while (!false) {
-        buf = static_cast<char>(lineStream.get());
-        if (buf == EOF) {
-            if (usesQuotes && record) {
-                Logger::warn("Entry value w/ quotes not terminated before EOL! (" + lineEnd + ")", false);
-                return std::nullopt;
-            }
-            return ret;
+    // Common case, a single quoted string or bare word is used as-is
+    if (usesQuotes) {
+        auto quoteBegin{lineEnd.find('"')};
+        auto quoteEnd{lineEnd.find('"', quoteBegin + 1)};
+        if (quoteEnd != std::string_view::npos && lineEnd.find('"', quoteEnd + 1) == std::string_view::npos) {
+            return lineEnd.substr(quoteBegin + 1, quoteEnd - quoteBegin - 1);
         }
+    } else {
+        auto trimmed{trim(lineEnd)};
+        if (trimmed.find_first_of(", \t") == std::string_view::npos) return trimmed;
+    }
 
+    bool record{false};
+    auto& ret{reader.valueBuf};
+    ret.clear();
+    for (const auto chr : lineEnd) {
         if (usesQuotes) {
-            if (buf == '"') {
+            if (chr == '"') {
                 record = !record;
                 if (record && !ret.empty()) ret += '\n';
                 continue;
             }
         } else {
-            if (buf == ',') {
+            if (chr == ',') {
                 ret += '\n';
                 continue;
             }
-            record = buf != ' ' && buf != '\t';
+            record = chr != ' ' && chr != '\t';
         }
 
-        if (record) ret += buf;
+        if (record) ret += chr;
     }
-}
 
-static std::optional<std::string> parseMultilineValue(std::istream& inStream) {
-    std::string ret;
+    if (usesQuotes && record) {
+        Logger::warn("Entry value w/ quotes not terminated before EOL! (" + std::string(lineEnd) + ")", false);
+        return std::nullopt;
+    }
+    return reader.store(ret);
+}
 
-    std::string buf;
-    while (std::getline(inStream, buf)) {
-        auto quoteBegin{buf.find('"')};
-        auto quoteEnd{buf.rfind('"')};
-        if (quoteBegin == std::string::npos || quoteBegin == quoteEnd) {
-            if (buf.find('}')) return ret;
-            continue;
+static std::optional<std::string_view> parseMultilineValue(DocumentReader& reader) {
+    // Single-line contents are used as-is, only joined lines need storage.
+    std::string_view firstLine;
+    size_t numLines{0};
+    auto& ret{reader.valueBuf};
+
+    while (auto line{reader.lines.nextLine()}) {
+        auto quoteBegin{line->find('"')};
+        auto quoteEnd{line->rfind('"')};
+        if (quoteBegin == std::string_view::npos || quoteBegin == quoteEnd) {
+            if (line->find('}') == std::string_view::npos) continue;
+            if (numLines <= 1) return firstLine;
+            return reader.store(ret);
         }
 
-        ret += buf.substr(quoteBegin + 1, quoteEnd - quoteBegin - 1) + '\n';
+        auto content{line->substr(quoteBegin + 1, quoteEnd - quoteBegin - 1)};
+        if (numLines == 0) firstLine = content;
+        else {
+            if (numLines == 1) ret.assign(firstLine);
+            ret += '\n';
+            ret += content;
+        }
+        numLines++;
     }
 
     Logger::warn("Reached end of segment before brace closed, likely a formatting issue!", false);
     return std::nullopt;
 }
 
-static std::optional<std::string> parseLabel(const std::string& line) {
-    std::string label;
+static std::optional<std::string_view> parseLabel(std::string_view line) {
     bool inParens{false};
-    bool inQuotes{false};
+    size_t labelBegin{std::string_view::npos};
 
-    for (char character : line) {
+    for (size_t idx{0}; idx < line.length(); idx++) {
+        const auto character{line[idx]};
         if (character == ':') return std::nullopt;
         if (character == '"' && !inParens) return std::nullopt;
 
@@ -215,18 +366,15 @@ static std::optional<std::string> parseLabel(const std::string& line) {
             continue;
         }
         if (character == '"' && inParens) {
-            if (inQuotes) return label;
-            inQuotes = true;
-            continue;
+            if (labelBegin != std::string_view::npos) return line.substr(labelBegin, idx - labelBegin);
+            labelBegin = idx + 1;
         }
-
-        if (inQuotes) label += character;
     }
 
     return std::nullopt;
 }
 
-static std::optional<int32_t> parseLabelNum(const std::string& line) {
+static std::optional<int32_t> parseLabelNum(std::string_view line) {
     auto numOpenBraces{std::count(line.begin(), line.end(), '{')};
     auto numCloseBraces{std::count(line.begin(), line.end(), '}')};
     bool correctNumBraces{(numOpenBraces == 1 || numOpenBraces == 2) && numCloseBraces == 1};
@@ -236,66 +384,91 @@ static std::optional<int32_t> parseLabelNum(const std::string& line) {
     auto closeBracePos{line.find('}')};
     bool bracesInOrder{openBracePos < closeBracePos};
     if (!bracesInOrder) {
-        Logger::warn("Entry has malplaced numeric label braces! (" + line + ")", false);
+        Logger::warn("Entry has malplaced numeric label braces! (" + std::string(line) + ")", false);
         return std::nullopt;
     }
 
-    auto numBeginIt{std::find_if(std::next(line.begin(), static_cast<int32_t>(openBracePos)), line.end(), [](char character) { return std::isdigit(character); })};
-    if (numBeginIt == line.end()) {
-        Logger::warn("Entry has empty/malformed numeric label! (" + line + ")", false);
+    auto numBegin{line.find_first_of("-0123456789", openBracePos)};
+    int32_t labelNum{0};
+    auto [ numEnd, err ]{std::from_chars(line.data() + std::min(numBegin, line.length()), line.data() + line.length(), labelNum)};
+    if (numBegin == std::string_view::npos || err != std::errc{}) {
+        Logger::warn("Entry has empty/malformed numeric label! (" + std::string(line) + ")", false);
         return std::nullopt;
     }
-    if ((numBeginIt - 1).base()[0] == '-') numBeginIt--;
 
-    return std::stoi(numBeginIt.base());
+    return labelNum;
 }
 
-static std::ostream& writeWithDepth(std::ostream& outStream, int32_t depth) {
-    for (int32_t i{0}; i < depth; i++) outStream << '\t';
-    return outStream;
+void PConf::Writer::writeDepth(int32_t depth) {
+    mBuffer.append(static_cast<size_t>(std::max(depth, 0)), '\t');
 }
 
-void PConf::writeEntry(std::ostream& outStream, const Entry& entry, int32_t depth) {
-    writeWithDepth(outStream, depth) << entry.name;
-    if (entry.label) outStream << "(\"" << entry.label.value() << "\")";
-    if (entry.labelNum) outStream << '{' << entry.labelNum.value() << '}';
+void PConf::Writer::writeHeader(const Entry& entry, int32_t depth) {
+    writeDepth(depth);
+    mBuffer += entry.name;
+    if (entry.label) {
+        mBuffer += "(\"";
+        mBuffer += entry.label.value();
+        mBuffer += "\")";
+    }
+    if (entry.labelNum) {
+        std::array<char, 12> numBuf{};
+        auto [ numEnd, err ]{std::to_chars(numBuf.begin(), numBuf.end(), entry.labelNum.value())};
+        mBuffer += '{';
+        mBuffer.append(numBuf.data(), numEnd);
+        mBuffer += '}';
+    }
+}
+
+void PConf::Writer::writeEntry(const Entry& entry, int32_t depth) {
+    writeHeader(entry, depth);
 
     if (!entry.value) {
-        outStream << std::endl;
+        mBuffer += '\n';
         return;
     }
 
-    const auto& valueStr{entry.value.value()};
-    outStream << ": ";
+    const auto valueStr{entry.value.value()};
+    mBuffer += ": ";
 
     size_t lineBegin{0};
     size_t lineEnd{valueStr.find('\n')};
-    if (lineEnd != std::string::npos) {
-        outStream << '{' << std::endl;
-        writeWithDepth(outStream, depth + 1);
+    if (lineEnd != std::string_view::npos) {
+        mBuffer += "{\n";
+        writeDepth(depth + 1);
     }
 
-    while (lineEnd != std::string::npos) {
-        outStream << '"' << valueStr.substr(lineBegin, lineEnd - lineBegin) << '"' << std::endl;
-        writeWithDepth(outStream, depth + 1);
+    while (lineEnd != std::string_view::npos) {
+        mBuffer += '"';
+        mBuffer.append(valueStr, lineBegin, lineEnd - lineBegin);
+        mBuffer += "\"\n";
+        writeDepth(depth + 1);
         lineBegin = lineEnd + 1;
         lineEnd = valueStr.find('\n', lineBegin);
     }
 
-    outStream << '"' << valueStr.substr(lineBegin, lineEnd - lineBegin) << '"' << std::endl;
-    if (lineBegin != 0) writeWithDepth(outStream, depth) << '}' << std::endl;
+    mBuffer += '"';
+    mBuffer.append(valueStr, lineBegin);
+    mBuffer += "\"\n";
+    if (lineBegin != 0) {
+        writeDepth(depth);
+        mBuffer += "}\n";
+    }
 }
 
-void PConf::writeSection(std::ostream& outStream, const Section& section, int32_t depth) {
-    writeWithDepth(outStream, depth) << section.name;
-    if (section.label) outStream << "(\"" << section.label.value() << "\")";
-    if (section.labelNum) outStream << '{' << section.labelNum.value() << '}';
-    outStream << " {" << std::endl;
+void PConf::Writer::writeSection(const Entry& section, int32_t depth) {
+    writeHeader(section, depth);
+    mBuffer += " {\n";
 
     for (const auto& entry : section.entries) {
-        if (entry->getType() == DataType::ENTRY) writeEntry(outStream, *entry, depth + 1);
-        else if (entry->getType() == DataType::SECTION) writeSection(outStream, *static_cast<Section*>(entry), depth + 1);
+        if (entry.getType() == DataType::ENTRY) writeEntry(entry, depth + 1);
+        else if (entry.getType() == DataType::SECTION) writeSection(entry, depth + 1);
     }
 
-    writeWithDepth(outStream, depth) << '}' << std::endl;
+    writeDepth(depth);
+    mBuffer += "}\n";
+}
+
+bool PConf::Writer::save(const std::string& filename) const {
+    return Utility::saveFile(filename, mBuffer);
 }
@@ -20,61 +20,173 @@
  */
 
 #include <cstdint>
+#include <istream>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_set>
-#include <vector>
 
 namespace PConf {
 
-struct Entry;
-struct Section;
+enum class DataType {
+    ENTRY,
+    SECTION
+};
 
-Entry* readEntry(std::istream& inStream, bool& isSection);
-Section* readSection(std::istream& inStream);
+/**
+ * Names ProffieConfig looks for, interned when a Document is read so
+ * entries can be switched on and found without string compares.
+ */
+#define ALL_KEYS \
+    KMAP(NAME,          "NAME") \
+    KMAP(FILENAME,      "FILENAME") \
+    KMAP(INFO,          "INFO") \
+    KMAP(SETTINGS,      "SETTINGS") \
+    KMAP(LAYOUT,        "LAYOUT") \
+    KMAP(BUTTONS,       "BUTTONS") \
+    KMAP(TOGGLE,        "TOGGLE") \
+    KMAP(OPTION,        "OPTION") \
+    KMAP(SELECTION,     "SELECTION") \
+    KMAP(NUMERIC,       "NUMERIC") \
+    KMAP(DECIMAL,       "DECIMAL") \
+    KMAP(DESCRIPTION,   "DESCRIPTION") \
+    KMAP(REQUIRE,       "REQUIRE") \
+    KMAP(REQUIREANY,    "REQUIREANY") \
+    KMAP(DISABLE,       "DISABLE") \
+    KMAP(OUTPUT,        "OUTPUT") \
+    KMAP(MINIMUM,       "MIN") \
+    KMAP(MAXIMUM,       "MAX") \
+    KMAP(DEFAULT,       "DEFAULT") \
+    KMAP(INCREMENT,     "INCREMENT") \
+    KMAP(SETTING,       "SETTING") \
+    KMAP(HORIZONTAL,    "HORIZONTAL") \
+    KMAP(VERTICAL,      "VERTICAL") \
+    KMAP(STATE,         "STATE") \
+    KMAP(BUTTON,        "BUTTON") \
+    KMAP(STYLEPRESET,   "STYLEPRESET") \
+    KMAP(STYLEALIAS,    "STYLEALIAS") \
+    KMAP(STYLE,         "STYLE") \
+    KMAP(ELEMENT,       "ELEMENT") \
+    KMAP(TYPE,          "TYPE") \
+    KMAP(OSNAME,        "OSNAME") \
+    KMAP(ARGUMENTS,     "ARGUMENTS") \
+    KMAP(DESC,          "DESC") \
+    KMAP(FIRSTRUN,      "FIRSTRUN") \
+    KMAP(PROPS,         "PROPS") \
+    KMAP(CONFIGS,       "CONFIGS") \
 
-void writeEntry(std::ostream& outStream, const Entry& entry, int32_t depth = 0);
-void writeSection(std::ostream& outStream, const Section& section, int32_t depth = 0);
+enum class Key : uint8_t {
+    UNKNOWN,
+#   define KMAP(enum, str) enum,
 
-std::unordered_set<std::string> setFromValue(const std::optional<std::string>& value);
+    ALL_KEYS
 
-enum class DataType {
-    ENTRY,
-    SECTION
+#   undef KMAP
 };
 
+[[nodiscard]] Key internKey(std::string_view name);
+
+/**
+ * An entry or section read from a Document.
+ *
+ * Entries are plain values, every string and the child span points
+ * into the Document they came from, so an Entry must not outlive it.
+ */
 struct Entry {
-    Entry() = default;
-    Entry(const Entry &) = default;
-    Entry(Entry &&) = delete;
-    Entry &operator=(const Entry &) = default;
-    Entry &operator=(Entry &&) = delete;
-    virtual ~Entry() = default;
-
-    std::string name;
-    std::optional<std::string> value{std::nullopt};
-    std::optional<std::string> label{std::nullopt};
+    std::string_view name{};
+    Key key{Key::UNKNOWN};
+    std::optional<std::string_view> value{std::nullopt};
+    std::optional<std::string_view> label{std::nullopt};
     std::optional<int32_t> labelNum{std::nullopt};
 
-    [[nodiscard]] virtual DataType getType() const { return DataType::ENTRY; }
+    DataType type{DataType::ENTRY};
+    /**
+     * Children of a section, stored contiguously
+     */
+    std::span<const Entry> entries{};
+    /**
+     * Bit set for each Key present in entries, and, ordered by Key,
+     * the index of the first entry with it.
+     */
+    uint64_t keyMask{0};
+    const uint16_t* keyIndex{nullptr};
+
+    [[nodiscard]] DataType getType() const { return type; }
+    /**
+     * Find the first child entry with key in O(1)
+     *
+     * @return nullptr if not present
+     */
+    [[nodiscard]] const Entry* find(Key key) const;
 };
 
-struct Section : Entry {
-    Section() = default;
-    Section(const Section &) = default;
-    Section(Section &&) = delete;
-    Section &operator=(const Section &) = default;
-    Section &operator=(Section &&) = delete;
-    ~Section() override {
-        for (auto &entry : entries) {
-            delete entry;
-            entry = nullptr;
-        }
-    }
-
-    std::vector<Entry*> entries;
-
-    [[nodiscard]] DataType getType() const override { return DataType::SECTION; }
+/**
+ * A parsed PConf file.
+ *
+ * The file contents and everything derived from them (entries, child
+ * arrays, values which had to be rewritten) live in a single buffer +
+ * arena, which is released all at once when the Document is destroyed.
+ */
+class Document {
+public:
+    Document();
+    Document(const Document&) = delete;
+    Document(Document&&) noexcept;
+    Document& operator=(const Document&) = delete;
+    Document& operator=(Document&&) noexcept;
+    ~Document();
+
+    /**
+     * Read a whole PConf file.
+     *
+     * The input is consumed front-to-back exactly once, without seeking,
+     * so any stream (including a pipe) or in-memory buffer works.
+     */
+    static Document read(std::istream& inStream);
+    static Document read(std::string buffer);
+
+    [[nodiscard]] std::span<const Entry> entries() const { return mRoot.entries; }
+    [[nodiscard]] const Entry* find(Key key) const { return mRoot.find(key); }
+
+private:
+    struct Storage;
+
+    std::unique_ptr<Storage> mStorage;
+    Entry mRoot{ .type = DataType::SECTION };
 };
 
+/**
+ * Formats entries into one buffer which is written out all at once.
+ *
+ * clear() keeps the allocation, so a Writer can be reused for repeated
+ * saves without reallocating.
+ */
+class Writer {
+public:
+    void writeEntry(const Entry& entry, int32_t depth = 0);
+    void writeSection(const Entry& section, int32_t depth = 0);
+
+    void reserve(size_t size) { mBuffer.reserve(size); }
+    void clear() { mBuffer.clear(); }
+    [[nodiscard]] std::string_view contents() const { return mBuffer; }
+
+    /**
+     * Write contents to a temporary file in a single write, then
+     * replace filename with it, so filename is never left half-written.
+     *
+     * @return if the file was successfully written
+     */
+    [[nodiscard]] bool save(const std::string& filename) const;
+
+private:
+    void writeDepth(int32_t depth);
+    void writeHeader(const Entry& entry, int32_t depth);
+
+    std::string mBuffer;
+};
+
+std::unordered_set<std::string> setFromValue(const std::optional<std::string_view>& value);
+
 } // namespace PConf
@@ -0,0 +1,87 @@
+#include "random.h"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * proffieconstructs/random.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+using namespace ProffieUtils;
+
+static inline uint32_t rotl(uint32_t val, int32_t shift) {
+    return (val << shift) | (val >> (32 - shift));
+}
+
+Random::Random(uint64_t seed) { this->seed(seed); }
+
+void Random::seed(uint64_t seed) {
+    // splitmix64, as recommended for seeding xoshiro. Never produces an all-zero lane.
+    for (size_t lane{0}; lane < LANES; lane++) {
+        for (size_t word{0}; word < mState.size(); word += 2) {
+            seed += 0x9E3779B97F4A7C15;
+            auto mixed{seed};
+            mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9;
+            mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EB;
+            mixed ^= mixed >> 31;
+            mState[word][lane] = static_cast<uint32_t>(mixed);
+            mState[word + 1][lane] = static_cast<uint32_t>(mixed >> 32);
+        }
+    }
+    mBufferPos = LANES;
+}
+
+uint32_t Random::next() {
+    if (mBufferPos == LANES) {
+        step(mBuffer.data());
+        mBufferPos = 0;
+    }
+    return mBuffer[mBufferPos++];
+}
+
+void Random::fill(std::span<uint32_t> out) {
+    auto outIt{out.begin()};
+
+    // Use up what's left over first, to stay in order with next()
+    const auto buffered{std::min<size_t>(LANES - mBufferPos, out.size())};
+    outIt = std::copy_n(mBuffer.begin() + static_cast<ptrdiff_t>(mBufferPos), buffered, outIt);
+    mBufferPos += buffered;
+
+    for (; out.end() - outIt >= static_cast<ptrdiff_t>(LANES); outIt += LANES) step(&*outIt);
+    for (; outIt != out.end(); outIt++) *outIt = next();
+}
+
+void Random::step(uint32_t* out) {
+    // Work on a copy so the compiler knows out can't alias the state.
+    auto state{mState};
+    auto& [ state0, state1, state2, state3 ]{state};
+    std::array<uint32_t, LANES> result;
+    for (size_t lane{0}; lane < LANES; lane++) {
+        result[lane] = rotl(state1[lane] * 5, 7) * 9;
+
+        const auto temp{state1[lane] << 9};
+        state2[lane] ^= state0[lane];
+        state3[lane] ^= state1[lane];
+        state1[lane] ^= state2[lane];
+        state0[lane] ^= state3[lane];
+        state2[lane] ^= temp;
+        state3[lane] = rotl(state3[lane], 11);
+    }
+    mState = state;
+    std::copy(result.begin(), result.end(), out);
+}
+
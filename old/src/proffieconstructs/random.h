@@ -0,0 +1,64 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * proffieconstructs/random.h
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace ProffieUtils {
+
+/**
+ * Random numbers for style evaluation. Each blade has its own, so renders
+ * are reproducible for a given seed and blades can render in parallel.
+ *
+ * This is LANES interleaved xoshiro128** generators, stepped together so
+ * fill() can be vectorized. Numbers come out in the same order whether
+ * they're taken with next() or fill().
+ */
+class Random {
+public:
+    static constexpr uint64_t DEFAULT_SEED{0x50524F4646494521}; // "PROFFIE!"
+
+    explicit Random(uint64_t seed = DEFAULT_SEED);
+
+    void seed(uint64_t seed);
+
+    uint32_t next();
+    void fill(std::span<uint32_t> out);
+
+private:
+    static constexpr size_t LANES{8};
+
+    /**
+     * Step every lane, writing one number per lane to out.
+     */
+    void step(uint32_t* out);
+
+    // xoshiro128** state, word-major so each word of every lane is contiguous
+    std::array<std::array<uint32_t, LANES>, 4> mState{};
+
+    std::array<uint32_t, LANES> mBuffer{};
+    size_t mBufferPos{LANES};
+};
+
+} // namespace ProffieUtils
+
@@ -31,6 +31,4 @@ constexpr inline float fract(float num) {
     return num - floorf(num);
 }
 
-uint32_t random();
-
 } // namespace ProffieUtils
@@ -0,0 +1,463 @@
+#include "propcache.h"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * prop/propcache.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "config/settings.h"
+#include "utility/mappedfile.h"
+#include "utility/savefile.h"
+
+/*
+ * Layout (all values native-endian, the cache is never shared between machines):
+ *
+ * MAGIC, VERSION, Key
+ * name, filename, info
+ * hasSettings [, count, { setting, peer defines }... ]
+ * hasLayout [, items ]
+ * button map count, { numButton, state count, { label, button count, { label, descriptions } } }
+ *
+ * Strings are a uint32_t length followed by the bytes. Settings refer to
+ * each other by define, and are resolved once all of them have been read.
+ */
+static constexpr std::array<char, 4> MAGIC{ 'P', 'C', 'P', 'C' };
+static constexpr uint32_t VERSION{2};
+
+namespace {
+
+using namespace Config::Setting;
+
+class CacheWriter {
+public:
+    template<typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        mBuffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    void writeString(std::string_view str) {
+        write(static_cast<uint32_t>(str.size()));
+        mBuffer.append(str);
+    }
+    void writeSet(const std::unordered_set<std::string>& set) {
+        write(static_cast<uint32_t>(set.size()));
+        for (const auto& str : set) writeString(str);
+    }
+
+    void writeSetting(const DefineBase& setting);
+    void writeLayout(const PropFile::Data::LayoutVec& layout);
+    void writeButtons(const PropFile::Data::Buttons& buttons);
+
+    [[nodiscard]] const std::string& buffer() const { return mBuffer; }
+
+private:
+    std::string mBuffer;
+};
+
+class CacheReader {
+public:
+    explicit CacheReader(std::span<const char> data) : mData(data) {}
+
+    template<typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T ret{};
+        if (sizeof(T) > mData.size() - mPos) {
+            mFailed = true;
+            return ret;
+        }
+        std::memcpy(&ret, mData.data() + mPos, sizeof(T));
+        mPos += sizeof(T);
+        return ret;
+    }
+    std::string readString() {
+        const auto length{read<uint32_t>()};
+        if (mFailed || length > mData.size() - mPos) {
+            mFailed = true;
+            return {};
+        }
+        std::string ret{mData.data() + mPos, length};
+        mPos += length;
+        return ret;
+    }
+    std::unordered_set<std::string> readSet() {
+        std::unordered_set<std::string> ret;
+        const auto count{read<uint32_t>()};
+        for (uint32_t i{0}; i < count && !mFailed; i++) ret.insert(readString());
+        return ret;
+    }
+
+    DefineBase* readSetting(std::vector<std::string>& peerDefines);
+    PropFile::Data::LayoutVec* readLayout(const DefineMap& settings, int32_t depth = 0);
+    void readButtons(PropFile::Data::Buttons& buttons, const DefineMap* settings);
+
+    [[nodiscard]] bool failed() const { return mFailed; }
+    [[nodiscard]] bool atEnd() const { return mPos == mData.size(); }
+
+private:
+    std::span<const char> mData;
+    size_t mPos{0};
+    bool mFailed{false};
+};
+
+} // namespace
+
+static void writeKey(CacheWriter& writer, const PropFile::Cache::Key& key);
+static PropFile::Cache::Key readKey(CacheReader& reader);
+static DefineBase* findSetting(const DefineMap* settings, const std::string& define);
+
+PropFile::Cache::Key PropFile::Cache::makeKey(std::span<const char> propContents, int64_t modifiedTime) {
+    // FNV-1a
+    uint64_t hash{0xcbf29ce484222325};
+    for (const auto chr : propContents) {
+        hash ^= static_cast<uint8_t>(chr);
+        hash *= 0x100000001b3;
+    }
+
+    return {
+        .size = propContents.size(),
+        .modifiedTime = modifiedTime,
+        .hash = hash,
+    };
+}
+
+PropFile::Data* PropFile::Cache::load(const std::string& cacheFilename, const Key& key) {
+    const Utility::MappedFile cacheFile{cacheFilename};
+    if (!cacheFile.isOpen()) return nullptr;
+
+    CacheReader reader{cacheFile.data()};
+    if (reader.read<std::array<char, 4>>() != MAGIC) return nullptr;
+    if (reader.read<uint32_t>() != VERSION) return nullptr;
+    if (reader.failed() || readKey(reader) != key) return nullptr;
+
+    auto *prop{new Data};
+    prop->name = reader.readString();
+    prop->filename = reader.readString();
+    prop->info = reader.readString();
+
+    if (reader.read<uint8_t>()) {
+        prop->settings = new DefineMap;
+
+        std::vector<std::pair<DefineBase*, std::vector<std::string>>> peers;
+        const auto numSettings{reader.read<uint32_t>()};
+        for (uint32_t i{0}; i < numSettings && !reader.failed(); i++) {
+            std::vector<std::string> peerDefines;
+            auto *setting{reader.readSetting(peerDefines)};
+            if (!setting) break;
+
+            prop->settings->emplace(setting->define, setting);
+            if (!peerDefines.empty()) peers.emplace_back(setting, std::move(peerDefines));
+        }
+
+        for (auto& [ setting, defines ] : peers) {
+            auto *selection{static_cast<Selection<DefineBase>*>(setting)};
+            for (const auto& define : defines) {
+                auto *peer{findSetting(prop->settings, define)};
+                if (peer && peer->getType() == SettingType::SELECTION) selection->peers.insert(static_cast<Selection<DefineBase>*>(peer));
+            }
+        }
+
+        linkDependencies(*prop->settings);
+    }
+
+    // A layout without settings is never written, so leaving it unread fails the atEnd() check below.
+    if (!reader.failed() && reader.read<uint8_t>() && prop->settings) prop->layout = reader.readLayout(*prop->settings);
+
+    if (!reader.failed()) reader.readButtons(prop->buttonControls, prop->settings);
+
+    if (reader.failed() || !reader.atEnd()) {
+        delete prop;
+        return nullptr;
+    }
+
+    return prop;
+}
+
+bool PropFile::Cache::save(const std::string& cacheFilename, const Key& key, const Data& prop) {
+    CacheWriter writer;
+    writer.write(MAGIC);
+    writer.write(VERSION);
+    writeKey(writer, key);
+
+    writer.writeString(prop.name);
+    writer.writeString(prop.filename);
+    writer.writeString(prop.info);
+
+    writer.write<uint8_t>(prop.settings != nullptr);
+    if (prop.settings) {
+        writer.write(static_cast<uint32_t>(prop.settings->size()));
+        for (const auto& [ define, setting ] : *prop.settings) writer.writeSetting(*setting);
+    }
+
+    writer.write<uint8_t>(prop.layout != nullptr);
+    if (prop.layout) writer.writeLayout(*prop.layout);
+
+    writer.writeButtons(prop.buttonControls);
+
+    return Utility::saveFile(cacheFilename, writer.buffer());
+}
+
+static void writeKey(CacheWriter& writer, const PropFile::Cache::Key& key) {
+    writer.write(key.size);
+    writer.write(key.modifiedTime);
+    writer.write(key.hash);
+}
+
+static PropFile::Cache::Key readKey(CacheReader& reader) {
+    PropFile::Cache::Key key;
+    key.size = reader.read<uint64_t>();
+    key.modifiedTime = reader.read<int64_t>();
+    key.hash = reader.read<uint64_t>();
+    return key;
+}
+
+static DefineBase* findSetting(const DefineMap* settings, const std::string& define) {
+    if (!settings) return nullptr;
+
+    const auto setting{settings->find(define)};
+    return setting == settings->end() ? nullptr : setting->second;
+}
+
+void CacheWriter::writeSetting(const DefineBase& setting) {
+    write(static_cast<uint8_t>(setting.getType()));
+    writeString(setting.name);
+    writeString(setting.description);
+    writeString(setting.define);
+    writeString(setting.postfix);
+    write<uint8_t>(setting.pureDef);
+    writeSet(setting.require);
+    write<uint8_t>(setting.requireAny);
+
+    switch (setting.getType()) {
+        case SettingType::TOGGLE: {
+            const auto& toggle{static_cast<const Toggle<DefineBase>&>(setting)};
+            writeSet(toggle.disable);
+            write<uint8_t>(toggle.value);
+            break; }
+        case SettingType::SELECTION: {
+            const auto& selection{static_cast<const Selection<DefineBase>&>(setting)};
+            writeSet(selection.disable);
+            write<uint8_t>(selection.value);
+            write<uint8_t>(selection.output);
+            write(static_cast<uint32_t>(selection.peers.size()));
+            for (const auto *peer : selection.peers) writeString(peer->define);
+            break; }
+        case SettingType::NUMERIC: {
+            const auto& numeric{static_cast<const Numeric<DefineBase>&>(setting)};
+            write(numeric.min);
+            write(numeric.max);
+            write(numeric.value);
+            write(numeric.increment);
+            break; }
+        case SettingType::DECIMAL: {
+            const auto& decimal{static_cast<const Decimal<DefineBase>&>(setting)};
+            write(decimal.min);
+            write(decimal.max);
+            write(decimal.value);
+            write(decimal.increment);
+            break; }
+        case SettingType::COMBO: {
+            const auto& combo{static_cast<const Combo<DefineBase>&>(setting)};
+            write(static_cast<uint32_t>(combo.options.size()));
+            for (const auto& [ option, value ] : combo.options) {
+                writeString(option);
+                writeString(value);
+            }
+            writeString(combo.value);
+            break; }
+    }
+}
+
+DefineBase* CacheReader::readSetting(std::vector<std::string>& peerDefines) {
+    const auto type{static_cast<SettingType>(read<uint8_t>())};
+
+    DefineBase* setting{nullptr};
+    switch (type) {
+        case SettingType::TOGGLE: setting = new Toggle<DefineBase>; break;
+        case SettingType::SELECTION: setting = new Selection<DefineBase>; break;
+        case SettingType::NUMERIC: setting = new Numeric<DefineBase>; break;
+        case SettingType::DECIMAL: setting = new Decimal<DefineBase>; break;
+        case SettingType::COMBO: setting = new Combo<DefineBase>; break;
+        default:
+            mFailed = true;
+            return nullptr;
+    }
+
+    setting->name = readString();
+    setting->description = readString();
+    setting->define = readString();
+    setting->postfix = readString();
+    setting->pureDef = read<uint8_t>();
+    setting->require = readSet();
+    setting->requireAny = read<uint8_t>();
+
+    switch (type) {
+        case SettingType::TOGGLE: {
+            auto *toggle{static_cast<Toggle<DefineBase>*>(setting)};
+            toggle->disable = readSet();
+            toggle->value = read<uint8_t>();
+            break; }
+        case SettingType::SELECTION: {
+            auto *selection{static_cast<Selection<DefineBase>*>(setting)};
+            selection->disable = readSet();
+            selection->value = read<uint8_t>();
+            selection->output = read<uint8_t>();
+            const auto numPeers{read<uint32_t>()};
+            for (uint32_t i{0}; i < numPeers && !mFailed; i++) peerDefines.push_back(readString());
+            break; }
+        case SettingType::NUMERIC: {
+            auto *numeric{static_cast<Numeric<DefineBase>*>(setting)};
+            numeric->min = read<int32_t>();
+            numeric->max = read<int32_t>();
+            numeric->value = read<int32_t>();
+            numeric->increment = read<int32_t>();
+            break; }
+        case SettingType::DECIMAL: {
+            auto *decimal{static_cast<Decimal<DefineBase>*>(setting)};
+            decimal->min = read<double>();
+            decimal->max = read<double>();
+            decimal->value = read<double>();
+            decimal->increment = read<double>();
+            break; }
+        case SettingType::COMBO: {
+            auto *combo{static_cast<Combo<DefineBase>*>(setting)};
+            const auto numOptions{read<uint32_t>()};
+            for (uint32_t i{0}; i < numOptions && !mFailed; i++) {
+                auto option{readString()};
+                combo->options.emplace(std::move(option), readString());
+            }
+            combo->value = readString();
+            break; }
+    }
+
+    if (mFailed) {
+        delete setting;
+        return nullptr;
+    }
+
+    return setting;
+}
+
+void CacheWriter::writeLayout(const PropFile::Data::LayoutVec& layout) {
+    write(static_cast<uint32_t>(layout.size()));
+    for (const auto *item : layout) {
+        write(static_cast<uint8_t>(item->getType()));
+        if (item->getType() == PropFile::LayoutType::ITEM) {
+            writeString(item->setting ? item->setting->define : "");
+            continue;
+        }
+
+        const auto *level{static_cast<const PropFile::Data::LayoutLevel*>(item)};
+        writeString(level->label);
+        write(static_cast<uint8_t>(level->direction));
+        if (level->items) writeLayout(*level->items);
+        else write<uint32_t>(0);
+    }
+}
+
+PropFile::Data::LayoutVec* CacheReader::readLayout(const DefineMap& settings, int32_t depth) {
+    // Guard against recursing forever on a corrupt file
+    constexpr int32_t MAX_DEPTH{64};
+    if (depth > MAX_DEPTH) {
+        mFailed = true;
+        return nullptr;
+    }
+
+    auto *items{new PropFile::Data::LayoutVec};
+    const auto numItems{read<uint32_t>()};
+    for (uint32_t i{0}; i < numItems && !mFailed; i++) {
+        const auto type{static_cast<PropFile::LayoutType>(read<uint8_t>())};
+        if (type == PropFile::LayoutType::ITEM) {
+            auto *layoutItem{new PropFile::Data::LayoutItem};
+            layoutItem->setting = findSetting(&settings, readString());
+            items->push_back(layoutItem);
+        } else if (type == PropFile::LayoutType::LEVEL) {
+            auto *layoutLevel{new PropFile::Data::LayoutLevel};
+            layoutLevel->label = readString();
+            layoutLevel->direction = static_cast<PropFile::Data::LayoutLevel::Direction>(read<uint8_t>());
+            layoutLevel->items = readLayout(settings, depth + 1);
+            items->push_back(layoutLevel);
+        } else {
+            mFailed = true;
+        }
+    }
+
+    return items;
+}
+
+void CacheWriter::writeButtons(const PropFile::Data::Buttons& buttons) {
+    write(static_cast<uint32_t>(buttons.size()));
+    for (const auto& [ numButton, buttonMap ] : buttons) {
+        write(buttonMap->numButton);
+        write(static_cast<uint32_t>(buttonMap->states.size()));
+        for (const auto *state : buttonMap->states) {
+            writeString(state->label);
+            write(static_cast<uint32_t>(state->buttons.size()));
+            for (const auto *button : state->buttons) {
+                writeString(button->label);
+                write(static_cast<uint32_t>(button->descriptions.size()));
+                for (const auto& [ setting, description ] : button->descriptions) {
+                    write<uint8_t>(setting != nullptr);
+                    if (setting) writeString(setting->define);
+                    writeString(description);
+                }
+            }
+        }
+    }
+}
+
+void CacheReader::readButtons(PropFile::Data::Buttons& buttons, const DefineMap* settings) {
+    const auto numMaps{read<uint32_t>()};
+    for (uint32_t i{0}; i < numMaps && !mFailed; i++) {
+        auto *buttonMap{new PropFile::Data::ButtonMap};
+        buttonMap->numButton = read<int8_t>();
+        // Buttons were saved from a map, so a repeated count means the cache is bad.
+        if (!buttons.emplace(buttonMap->numButton, buttonMap).second) {
+            delete buttonMap;
+            mFailed = true;
+            break;
+        }
+
+        const auto numStates{read<uint32_t>()};
+        for (uint32_t j{0}; j < numStates && !mFailed; j++) {
+            auto *state{new PropFile::Data::ButtonState};
+            state->label = readString();
+            buttonMap->states.insert(state);
+
+            const auto numButtons{read<uint32_t>()};
+            for (uint32_t k{0}; k < numButtons && !mFailed; k++) {
+                auto *button{new PropFile::Data::Button};
+                button->label = readString();
+                state->buttons.push_back(button);
+
+                const auto numDescriptions{read<uint32_t>()};
+                for (uint32_t l{0}; l < numDescriptions && !mFailed; l++) {
+                    DefineBase* setting{nullptr};
+                    if (read<uint8_t>()) setting = findSetting(settings, readString());
+                    button->descriptions.emplace(setting, readString());
+                }
+            }
+        }
+    }
+}
+
@@ -0,0 +1,60 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * prop/propcache.h
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include "prop/propfile.h"
+
+/**
+ * Binary snapshot of a parsed PropFile::Data, stored alongside the prop
+ * file it was parsed from so the text parse can be skipped on later runs.
+ */
+namespace PropFile::Cache {
+
+/**
+ * Identifies the exact prop file contents a cache was built from.
+ */
+struct Key {
+    uint64_t size{0};
+    int64_t modifiedTime{0};
+    uint64_t hash{0};
+
+    bool operator==(const Key&) const = default;
+};
+
+[[nodiscard]] Key makeKey(std::span<const char> propContents, int64_t modifiedTime);
+
+/**
+ * Load cached prop data
+ *
+ * @return the prop data, or nullptr if the cache is missing, stale, or unreadable
+ */
+[[nodiscard]] Data* load(const std::string& cacheFilename, const Key& key);
+
+/**
+ * @return if the cache was successfully written
+ */
+bool save(const std::string& cacheFilename, const Key& key, const Data& prop);
+
+} // namespace PropFile::Cache
+
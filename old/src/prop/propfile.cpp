@@ -19,27 +19,34 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <optional>
+#include <span>
 #include <string>
+#include <thread>
 
 #include "config/settings.h"
 #include "log/logger.h"
 #include "pconf/pconf.h"
+#include "prop/propcache.h"
+#include "utility/mappedfile.h"
 
-PropFile::Data* readProp(const std::string& filename);
+PropFile::Data* readProp(const std::string& propDir, const std::string& filename);
 
-static Config::Setting::DefineMap* parsePropSettings(const PConf::Section& settingsSection);
-static PropFile::Data::LayoutVec* parsePropLayout(const PConf::Section& layoutSection, const Config::Setting::DefineMap& settings);
-static PropFile::Data::ButtonMap* parsePropButtons(const PConf::Section& buttonsSection, const Config::Setting::DefineMap* settings);
+static Config::Setting::DefineMap* parsePropSettings(const PConf::Entry& settingsSection);
+static PropFile::Data::LayoutVec* parsePropLayout(const PConf::Entry& layoutSection, const Config::Setting::DefineMap& settings);
+static PropFile::Data::ButtonMap* parsePropButtons(const PConf::Entry& buttonsSection, const Config::Setting::DefineMap* settings);
 
-static void checkSettingCommon(const PConf::Entry& entry, Config::Setting::DefineBase& setting);
-static void generateSettingCommon(Config::Setting::DefineBase& setting, const PConf::Section& section, const Config::Setting::DefineMap& settingMap);
-static Config::Setting::Toggle<Config::Setting::DefineBase>* generateToggle(const PConf::Section& toggleSection, const Config::Setting::DefineMap& settingMap);
-static std::vector<Config::Setting::Selection<Config::Setting::DefineBase>*> generateOptionSelections(const PConf::Section& optionSection, const Config::Setting::DefineMap& settingMap);
-static Config::Setting::Numeric<Config::Setting::DefineBase>* generateNumeric(const PConf::Section& numericSection, const Config::Setting::DefineMap& settingMap);
-static Config::Setting::Decimal<Config::Setting::DefineBase>* generateDecimal(const PConf::Section& decimalSection, const Config::Setting::DefineMap& settingMap);
+static void checkSettingCommon(const PConf::Entry& section, Config::Setting::DefineBase& setting);
+static void generateSettingCommon(Config::Setting::DefineBase& setting, const PConf::Entry& section);
+static Config::Setting::Toggle<Config::Setting::DefineBase>* generateToggle(const PConf::Entry& toggleSection);
+static std::vector<Config::Setting::Selection<Config::Setting::DefineBase>*> generateOptionSelections(const PConf::Entry& optionSection);
+static Config::Setting::Numeric<Config::Setting::DefineBase>* generateNumeric(const PConf::Entry& numericSection);
+static Config::Setting::Decimal<Config::Setting::DefineBase>* generateDecimal(const PConf::Entry& decimalSection);
 
-static std::vector<PropFile::Data::Button*> parseButtonState(const std::vector<PConf::Entry*>& buttonEntries, const Config::Setting::DefineMap* settings);
+static std::vector<PropFile::Data::Button*> parseButtonState(std::span<const PConf::Entry> buttonEntries, const Config::Setting::DefineMap* settings);
 
 PropFile::Data::~Data() {
     if (settings) {
@@ -59,10 +66,32 @@ std::vector<PropFile::Data*> PropFile::getPropData(const std::vector<std::string
     static std::unordered_map<std::string, PropFile::Data*> propData{};
     static std::unordered_set<std::string> propNames{};
 
+    std::vector<std::string> toRead;
     for (const auto& file : pConfs) {
         if (propData.find(file) != propData.end()) continue;
+        if (std::find(toRead.begin(), toRead.end(), file) != toRead.end()) continue;
+        toRead.push_back(file);
+    }
+
+    // Files are independent, so parse them concurrently and merge in order afterwards.
+    const auto propDir{wxGetCwd().ToStdString() + PROPPATH};
+    std::vector<PropFile::Data*> readProps(toRead.size(), nullptr);
+    std::atomic<size_t> nextFile{0};
+    const auto readWorker{[&]() {
+        for (auto idx{nextFile++}; idx < toRead.size(); idx = nextFile++) {
+            readProps[idx] = readProp(propDir, toRead[idx]);
+        }
+    }};
+
+    const auto numThreads{std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1U), toRead.size())};
+    std::vector<std::thread> workers;
+    workers.reserve(numThreads > 0 ? numThreads - 1 : 0);
+    for (size_t i{1}; i < numThreads; i++) workers.emplace_back(readWorker);
+    readWorker();
+    for (auto& worker : workers) worker.join();
 
-        auto *prop{readProp(file)};
+    for (size_t idx{0}; idx < toRead.size(); idx++) {
+        auto *prop{readProps[idx]};
         if (!prop) continue;
 
         if (propNames.find(prop->name) != propNames.end()) {
@@ -72,7 +101,7 @@ std::vector<PropFile::Data*> PropFile::getPropData(const std::vector<std::string
         }
 
         propNames.insert(prop->name);
-        propData.emplace(file, prop);
+        propData.emplace(toRead[idx], prop);
     }
 
     std::vector<PropFile::Data*> ret;
@@ -84,116 +113,128 @@ std::vector<PropFile::Data*> PropFile::getPropData(const std::vector<std::string
     return ret;
 }
 
-PropFile::Data* readProp(const std::string& filename) {
-    std::ifstream propFile(wxGetCwd().ToStdString() + PROPPATH + filename);
-    if (!propFile.is_open()) {
+PropFile::Data* readProp(const std::string& propDir, const std::string& filename) {
+    const auto propPath{propDir + filename};
+    const Utility::MappedFile propFile{propPath};
+    if (!propFile.isOpen()) {
         Logger::error("Prop file \"" + filename + "\" not found, skipping!", false);
         return nullptr;
     }
 
+    const auto cachePath{propPath + ".cache"};
+    const auto cacheKey{PropFile::Cache::makeKey(propFile.data(), propFile.modifiedTime())};
+    if (auto *prop{PropFile::Cache::load(cachePath, cacheKey)}) return prop;
+
+    auto file{PConf::Document::read(std::string{propFile.data().begin(), propFile.data().end()})};
     auto *prop{new PropFile::Data};
-    bool foundSect{false};
-
-    while (propFile.peek() != EOF) {
-        std::unique_ptr<PConf::Entry> entry{PConf::readEntry(propFile, foundSect)};
-        if (foundSect) {
-            std::unique_ptr<PConf::Section> sect{PConf::readSection(propFile)};
-            if (!sect) continue;
-            if (sect->name == "SETTINGS") prop->settings = parsePropSettings(*sect);
-            else if (sect->name == "LAYOUT") {
-                if (!prop->settings) {
-                    Logger::warn("Missing/out of order settings section, ignoring layout section!", false);
-                    continue;
-                }
-                prop->layout = parsePropLayout(*sect, *prop->settings);
-            } else if (sect->name == "BUTTONS") {
-                auto *buttonMap{parsePropButtons(*sect, prop->settings)};
-                if (buttonMap) prop->buttonControls.emplace(buttonMap->numButton, buttonMap);
-            }
-        }
-        if (!entry) continue;
-        if (entry->name == "NAME") prop->name = entry->value.value_or("");
-        if (entry->name == "FILENAME") prop->filename = entry->value.value_or("");
-        if (entry->name == "INFO") prop->info = entry->value.value_or("");
+
+    if (const auto *name{file.find(PConf::Key::NAME)}) prop->name = name->value.value_or("");
+    if (const auto *propFilename{file.find(PConf::Key::FILENAME)}) prop->filename = propFilename->value.value_or("");
+    if (const auto *info{file.find(PConf::Key::INFO)}) prop->info = info->value.value_or("");
+
+    const auto *settings{file.find(PConf::Key::SETTINGS)};
+    if (settings && settings->getType() == PConf::DataType::SECTION) prop->settings = parsePropSettings(*settings);
+
+    const auto *layout{file.find(PConf::Key::LAYOUT)};
+    if (layout && layout->getType() == PConf::DataType::SECTION) {
+        if (prop->settings) prop->layout = parsePropLayout(*layout, *prop->settings);
+        else Logger::warn("Missing settings section, ignoring layout section!", false);
+    }
+
+    for (const auto& entry : file.entries()) {
+        if (entry.key != PConf::Key::BUTTONS || entry.getType() != PConf::DataType::SECTION) continue;
+
+        auto *buttonMap{parsePropButtons(entry, prop->settings)};
+        if (buttonMap) prop->buttonControls.emplace(buttonMap->numButton, buttonMap);
+    }
+
+    if (!PropFile::Cache::save(cachePath, cacheKey, *prop)) {
+        Logger::info("Could not write cache for prop file \"" + filename + "\".", false);
     }
 
     return prop;
 };
 
-static Config::Setting::DefineMap* parsePropSettings(const PConf::Section& settingsSection) {
+static Config::Setting::DefineMap* parsePropSettings(const PConf::Entry& settingsSection) {
     auto *settings{new Config::Setting::DefineMap};
 
     for (const auto& entry : settingsSection.entries) {
-        if (entry->getType() != PConf::DataType::SECTION) {
-            Logger::warn("Stray entry in settings! (" + entry->name + ")", false);
+        if (entry.getType() != PConf::DataType::SECTION) {
+            Logger::warn("Stray entry in settings! (" + std::string(entry.name) + ")", false);
             continue;
         }
 
 
-        if (entry->name == "TOGGLE") {
-            auto *toggle{generateToggle(*static_cast<PConf::Section*>(entry), *settings)};
-            if (toggle) settings->emplace(toggle->define, toggle);
-        } else if (entry->name == "OPTION") {
-            for (const auto& selection : generateOptionSelections(*static_cast<PConf::Section*>(entry), *settings)) {
-                settings->emplace(selection->define, selection);
-            }
-        } else if (entry->name == "NUMERIC") {
-            auto *numeric{generateNumeric(*static_cast<PConf::Section*>(entry), *settings)};
-            if (numeric) settings->emplace(numeric->define, numeric);
-        } else if (entry->name == "DECIMAL") {
-            auto *decimal{generateDecimal(*static_cast<PConf::Section*>(entry), *settings)};
-            if (decimal) settings->emplace(decimal->define, decimal);
+        switch (entry.key) {
+            case PConf::Key::TOGGLE: {
+                auto *toggle{generateToggle(entry)};
+                if (toggle) settings->emplace(toggle->define, toggle);
+                break; }
+            case PConf::Key::OPTION:
+                for (const auto& selection : generateOptionSelections(entry)) {
+                    settings->emplace(selection->define, selection);
+                }
+                break;
+            case PConf::Key::NUMERIC: {
+                auto *numeric{generateNumeric(entry)};
+                if (numeric) settings->emplace(numeric->define, numeric);
+                break; }
+            case PConf::Key::DECIMAL: {
+                auto *decimal{generateDecimal(entry)};
+                if (decimal) settings->emplace(decimal->define, decimal);
+                break; }
+            default:
+                break;
         }
     }
 
+    Config::Setting::linkDependencies(*settings);
     return settings;
 }
 
-static void checkSettingCommon(const PConf::Entry& entry, Config::Setting::DefineBase& setting) {
-    if (entry.name == "NAME") setting.name = entry.value.value_or("");
-    else if (entry.name == "DESCRIPTION") setting.description = entry.value.value_or("");
-    else if (entry.name == "REQUIRE" || entry.name == "REQUIREANY") {
-        setting.require = PConf::setFromValue(entry.value);
-        setting.requireAny = entry.name == "REQUIREANY";
+static void checkSettingCommon(const PConf::Entry& section, Config::Setting::DefineBase& setting) {
+    if (const auto *name{section.find(PConf::Key::NAME)}) setting.name = name->value.value_or("");
+    if (const auto *description{section.find(PConf::Key::DESCRIPTION)}) setting.description = description->value.value_or("");
+    if (const auto *require{section.find(PConf::Key::REQUIRE)}) {
+        setting.require = PConf::setFromValue(require->value);
+        setting.requireAny = false;
+    } else if (const auto *requireAny{section.find(PConf::Key::REQUIREANY)}) {
+        setting.require = PConf::setFromValue(requireAny->value);
+        setting.requireAny = true;
     }
 }
-static void generateSettingCommon(Config::Setting::DefineBase& setting, const PConf::Section& section, const Config::Setting::DefineMap& settingMap) {
+static void generateSettingCommon(Config::Setting::DefineBase& setting, const PConf::Entry& section) {
     setting.define = section.label.value();
-    setting.group = settingMap;
 }
 
-static Config::Setting::Toggle<Config::Setting::DefineBase>* generateToggle(const PConf::Section& toggleSection, const Config::Setting::DefineMap& settingMap) {
+static Config::Setting::Toggle<Config::Setting::DefineBase>* generateToggle(const PConf::Entry& toggleSection) {
     if (!toggleSection.label) {
         Logger::warn("Define has no define, skipping!");
         return nullptr;
     }
 
     auto *toggle{new Config::Setting::Toggle<Config::Setting::DefineBase>};
-    generateSettingCommon(*toggle, toggleSection, settingMap);
-    for (const auto& entry : toggleSection.entries) {
-        checkSettingCommon(*entry, *toggle);
-        if (entry->name == "DISABLE") toggle->disable = PConf::setFromValue(entry->value);
-    }
+    generateSettingCommon(*toggle, toggleSection);
+    checkSettingCommon(toggleSection, *toggle);
+    if (const auto *disable{toggleSection.find(PConf::Key::DISABLE)}) toggle->disable = PConf::setFromValue(disable->value);
 
     return toggle;
 }
 
-static std::vector<Config::Setting::Selection<Config::Setting::DefineBase>*> generateOptionSelections(const PConf::Section& optionSection, const Config::Setting::DefineMap& settingMap) {
+static std::vector<Config::Setting::Selection<Config::Setting::DefineBase>*> generateOptionSelections(const PConf::Entry& optionSection) {
     std::vector<Config::Setting::Selection<Config::Setting::DefineBase>*> selections;
     for (const auto& entry : optionSection.entries) {
-        if (entry->name == "SELECTION" && entry->getType() == PConf::DataType::SECTION) {
-            if (!entry->label) {
+        if (entry.key == PConf::Key::SELECTION && entry.getType() == PConf::DataType::SECTION) {
+            if (!entry.label) {
                 Logger::warn("Define has no define, skipping!");
                 continue;
             }
 
             auto *selection{new Config::Setting::Selection<Config::Setting::DefineBase>};
-            generateSettingCommon(*selection, *static_cast<PConf::Section*>(entry), settingMap);
-            for (auto *const selectionEntry : static_cast<PConf::Section*>(entry)->entries) {
-                checkSettingCommon(*selectionEntry, *selection);
-                if (entry->name == "DISABLE") selection->disable = PConf::setFromValue(entry->value);
-                if (selectionEntry->name == "OUTPUT") selection->output = selectionEntry->value.value_or("TRUE") != "FALSE";
-            }
+            generateSettingCommon(*selection, entry);
+            checkSettingCommon(entry, *selection);
+            if (const auto *disable{entry.find(PConf::Key::DISABLE)}) selection->disable = PConf::setFromValue(disable->value);
+            if (const auto *output{entry.find(PConf::Key::OUTPUT)}) selection->output = output->value.value_or("TRUE") != "FALSE";
 
             selections.push_back(selection);
         }
@@ -209,90 +250,100 @@ static std::vector<Config::Setting::Selection<Config::Setting::DefineBase>*> gen
     return selections;
 }
 
-static auto isNum = [](const std::string& str) -> bool {
+static auto isNum = [](std::string_view str) -> bool {
     if (str.empty()) return false;
     if (str.length() == 1) return std::isdigit(str.at(0));
 
     return (std::isdigit(str.at(0)) || (str.at(0) == '-' && std::isdigit(str.at(1))));
 };
 
+static std::optional<int32_t> findInt(const PConf::Entry& section, PConf::Key key) {
+    const auto *entry{section.find(key)};
+    if (!entry || !entry->value || !isNum(*entry->value)) return std::nullopt;
 
-static Config::Setting::Numeric<Config::Setting::DefineBase>* generateNumeric(const PConf::Section& numericSection, const Config::Setting::DefineMap& settingMap) {
+    int32_t ret{0};
+    const auto val{entry->value.value()};
+    std::from_chars(val.data(), val.data() + val.length(), ret);
+    return ret;
+}
+
+static std::optional<double> findDouble(const PConf::Entry& section, PConf::Key key) {
+    const auto *entry{section.find(key)};
+    if (!entry || !entry->value || !isNum(*entry->value)) return std::nullopt;
+
+    return std::stod(std::string{entry->value.value()});
+}
+
+static Config::Setting::Numeric<Config::Setting::DefineBase>* generateNumeric(const PConf::Entry& numericSection) {
     if (!numericSection.label) {
         Logger::warn("Define has no define, skipping!");
         return nullptr;
     }
 
     auto *numeric{new Config::Setting::Numeric<Config::Setting::DefineBase>};
-    generateSettingCommon(*numeric, numericSection, settingMap);
-    for (auto *const entry : numericSection.entries) {
-        checkSettingCommon(*entry, *numeric);
-        const auto& val = entry->value.value_or(" ");
-        if (entry->name == "MIN" && isNum(val)) numeric->min = stoi(val);
-        if (entry->name == "MAX" && isNum(val)) numeric->max = stoi(val);
-        if (entry->name == "DEFAULT" && isNum(val)) numeric->value = stoi(val);
-        if (entry->name == "INCREMENT" && isNum(val)) numeric->increment = stoi(val);
-    }
+    generateSettingCommon(*numeric, numericSection);
+    checkSettingCommon(numericSection, *numeric);
+    numeric->min = findInt(numericSection, PConf::Key::MINIMUM).value_or(numeric->min);
+    numeric->max = findInt(numericSection, PConf::Key::MAXIMUM).value_or(numeric->max);
+    numeric->value = findInt(numericSection, PConf::Key::DEFAULT).value_or(numeric->value);
+    numeric->increment = findInt(numericSection, PConf::Key::INCREMENT).value_or(numeric->increment);
 
     return numeric;
 }
 
-static Config::Setting::Decimal<Config::Setting::DefineBase>* generateDecimal(const PConf::Section& decimalSection, const Config::Setting::DefineMap& settingMap) {
+static Config::Setting::Decimal<Config::Setting::DefineBase>* generateDecimal(const PConf::Entry& decimalSection) {
     if (!decimalSection.label) {
         Logger::warn("Define has no define, skipping!");
         return nullptr;
     }
 
     auto *decimal{new Config::Setting::Decimal<Config::Setting::DefineBase>};
-    generateSettingCommon(*decimal, decimalSection, settingMap);
-    for (auto *const entry : decimalSection.entries) {
-        checkSettingCommon(*entry, *decimal);
-        const auto& val = entry->value.value_or(" ");
-        if (entry->name == "MIN" && isNum(val)) decimal->min = stod(val);
-        if (entry->name == "MAX" && isNum(val)) decimal->max = stod(val);
-        if (entry->name == "DEFAULT" && isNum(val)) decimal->value = stod(val);
-        if (entry->name == "INCREMENT" && isNum(val)) decimal->increment = stod(val);
-    }
+    generateSettingCommon(*decimal, decimalSection);
+    checkSettingCommon(decimalSection, *decimal);
+    decimal->min = findDouble(decimalSection, PConf::Key::MINIMUM).value_or(decimal->min);
+    decimal->max = findDouble(decimalSection, PConf::Key::MAXIMUM).value_or(decimal->max);
+    decimal->value = findDouble(decimalSection, PConf::Key::DEFAULT).value_or(decimal->value);
+    decimal->increment = findDouble(decimalSection, PConf::Key::INCREMENT).value_or(decimal->increment);
 
     return decimal;
 }
 
-static PropFile::Data::LayoutVec* parsePropLayout(const PConf::Section& layoutSection, const Config::Setting::DefineMap& settings) {
+static PropFile::Data::LayoutVec* parsePropLayout(const PConf::Entry& layoutSection, const Config::Setting::DefineMap& settings) {
     auto *items{new PropFile::Data::LayoutVec};
 
-    for (auto *const entry : layoutSection.entries) {
-        if (entry->name == "SETTING") {
-            if (!entry->label) {
+    for (const auto& entry : layoutSection.entries) {
+        if (entry.key == PConf::Key::SETTING) {
+            if (!entry.label) {
                 Logger::warn("Layout entry missing label, skipping!", false);
                 continue;
             }
-            const auto& setting{settings.find(entry->label.value())};
+            const auto& setting{settings.find(std::string(entry.label.value()))};
             if (setting == settings.end()) {
-                Logger::warn("Layout entry has unknown setting, skipping! (" + entry->label.value() + ")", false);
+                Logger::warn("Layout entry has unknown setting, skipping! (" + std::string(entry.label.value()) + ")", false);
                 continue;
             }
             auto *layoutItem{new PropFile::Data::LayoutItem};
             layoutItem->setting = setting->second;
             items->push_back(layoutItem);
-        } else if (entry->name == "HORIZONTAL") {
-            if (entry->getType() != PConf::DataType::SECTION) {
-                Logger::warn("Horizontal layout section interpreted as entry due to syntax error, skipping!" + (entry->label ? " (" + entry->label.value() + ")" : ""), false);
+        } else if (entry.key == PConf::Key::HORIZONTAL) {
+            if (entry.getType() != PConf::DataType::SECTION) {
+                Logger::warn("Horizontal layout section interpreted as entry due to syntax error, skipping!" + (entry.label ? " (" + std::string(entry.label.value()) + ")" : ""), false);
                 continue;
             }
             auto *layoutLevel{new PropFile::Data::LayoutLevel};
             layoutLevel->direction = PropFile::Data::LayoutLevel::Direction::HORIZONTAL;
-            layoutLevel->label = entry->label.value_or("");
-            layoutLevel->items = parsePropLayout(*static_cast<PConf::Section*>(entry), settings);
+            layoutLevel->label = entry.label.value_or("");
+            layoutLevel->items = parsePropLayout(entry, settings);
             items->push_back(layoutLevel);
-        } else if (entry->name == "VERTICAL") {
-            if (entry->getType() != PConf::DataType::SECTION) {
-                Logger::warn("Vertical layout section interpreted as entry due to syntax error, skipping!" + (entry->label ? " (" + entry->label.value() + ")" : ""), false);
+        } else if (entry.key == PConf::Key::VERTICAL) {
+            if (entry.getType() != PConf::DataType::SECTION) {
+                Logger::warn("Vertical layout section interpreted as entry due to syntax error, skipping!" + (entry.label ? " (" + std::string(entry.label.value()) + ")" : ""), false);
                 continue;
             }
             auto *layoutLevel{new PropFile::Data::LayoutLevel};
             layoutLevel->direction = PropFile::Data::LayoutLevel::Direction::VERTICAL;
-            layoutLevel->label = entry->label.value_or("");
-            layoutLevel->items = parsePropLayout(*static_cast<PConf::Section*>(entry), settings);
+            layoutLevel->label = entry.label.value_or("");
+            layoutLevel->items = parsePropLayout(entry, settings);
             items->push_back(layoutLevel);
         }
     }
@@ -300,7 +351,7 @@ static PropFile::Data::LayoutVec* parsePropLayout(const PConf::Section& layoutSe
     return items;
 }
 
-static PropFile::Data::ButtonMap* parsePropButtons(const PConf::Section& buttonsSection, const Config::Setting::DefineMap* settings) {
+static PropFile::Data::ButtonMap* parsePropButtons(const PConf::Entry& buttonsSection, const Config::Setting::DefineMap* settings) {
     if (buttonsSection.labelNum.value_or(-1) < 0) {
         Logger::warn("Button section missing numeric label, ignoring!", false);
         return nullptr;
@@ -310,19 +361,19 @@ static PropFile::Data::ButtonMap* parsePropButtons(const PConf::Section& buttons
     buttonMap->numButton = static_cast<int8_t>(buttonsSection.labelNum.value());
 
     for (const auto& stateEntry : buttonsSection.entries) {
-        if (stateEntry->name == "STATE") {
-            if (!stateEntry->label) {
+        if (stateEntry.key == PConf::Key::STATE) {
+            if (!stateEntry.label) {
                 Logger::warn("Button state section missing label, skipping!", false);
                 continue;
             }
-            if (stateEntry->getType() != PConf::DataType::SECTION) {
-                Logger::warn("Button state \"" + stateEntry->label.value() + "\" interpreted as entry due to syntax error, skipping!", false);
+            if (stateEntry.getType() != PConf::DataType::SECTION) {
+                Logger::warn("Button state \"" + std::string(stateEntry.label.value()) + "\" interpreted as entry due to syntax error, skipping!", false);
                 continue;
             }
 
             auto *state{new PropFile::Data::ButtonState};
-            state->label = stateEntry->label.value();
-            state->buttons = parseButtonState(static_cast<PConf::Section*>(stateEntry)->entries, settings);
+            state->label = stateEntry.label.value();
+            state->buttons = parseButtonState(stateEntry.entries, settings);
 
             buttonMap->states.insert(state);
         }
@@ -332,29 +383,29 @@ static PropFile::Data::ButtonMap* parsePropButtons(const PConf::Section& buttons
     return buttonMap;
 }
 
-static std::vector<PropFile::Data::Button*> parseButtonState(const std::vector<PConf::Entry*>& buttonEntries, const Config::Setting::DefineMap* settings) {
+static std::vector<PropFile::Data::Button*> parseButtonState(std::span<const PConf::Entry> buttonEntries, const Config::Setting::DefineMap* settings) {
     std::vector<PropFile::Data::Button*> buttons;
     for (const auto& buttonEntry : buttonEntries) {
-        if (!buttonEntry->label) {
+        if (!buttonEntry.label) {
             Logger::warn("Button section missing label, skipping!", false);
             continue;
         }
-        if (buttonEntry->getType() != PConf::DataType::SECTION) {
-            Logger::warn("Button section \"" + buttonEntry->label.value() + "\" interpreted as entry due to syntax error, skipping!", false);
+        if (buttonEntry.getType() != PConf::DataType::SECTION) {
+            Logger::warn("Button section \"" + std::string(buttonEntry.label.value()) + "\" interpreted as entry due to syntax error, skipping!", false);
             continue;
         }
 
         auto *button{new PropFile::Data::Button};
-        button->label = buttonEntry->label.value();
+        button->label = buttonEntry.label.value();
 
-        for (const auto& description : static_cast<PConf::Section*>(buttonEntry)->entries) {
+        for (const auto& description : buttonEntry.entries) {
             if (!settings) {
-                button->descriptions.emplace(nullptr, description->value.value_or(""));
+                button->descriptions.emplace(nullptr, description.value.value_or(""));
                 break;
             }
 
-            const auto& setting{settings->find(description->label.value_or(""))};
-            button->descriptions.emplace((setting == settings->end() ? nullptr : setting->second), description->value.value_or(""));
+            const auto& setting{settings->find(std::string(description.label.value_or("")))};
+            button->descriptions.emplace((setting == settings->end() ? nullptr : setting->second), description.value.value_or(""));
         }
 
         buttons.push_back(button);
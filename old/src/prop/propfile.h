@@ -72,10 +72,9 @@ struct Data::LayoutItem {
     LayoutItem(LayoutItem &&) = delete;
     LayoutItem &operator=(const LayoutItem &) = default;
     LayoutItem &operator=(LayoutItem &&) = delete;
-    virtual ~LayoutItem() {
-        delete setting;
-    }
+    virtual ~LayoutItem() = default;
 
+    // Owned by Data::settings
     Config::Setting::DefineBase *setting{nullptr};
 
     [[nodiscard]] virtual LayoutType getType() const { return LayoutType::ITEM; }
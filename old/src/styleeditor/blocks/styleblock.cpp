@@ -148,21 +148,17 @@ void StyleBlock::bindEvents() {
 }
 
 void StyleBlock::bindChildren() {
-    for (const auto& param : pStyle->getParams()) {
-        if (!(param->getType() & BladeStyles::STYLETYPE)) continue;
-        const auto *styleParam{static_cast<const BladeStyles::StyleParam*>(param)};
-        const auto *style{styleParam->getStyle()};
+    for (size_t i{0}; i < pStyle->getParams().size(); i++) {
+        auto *style{pStyle->getMutableParamStyle(i)};
         if (!style) continue;
 
-        new StyleBlock(pMoveArea, this, const_cast<BladeStyles::BladeStyle*>(style));
+        new StyleBlock(pMoveArea, this, style);
     }
 }
 
 std::optional<std::string> StyleBlock::getString() const { 
     const auto *style{getStyle()};
-    auto ret{BladeStyles::asString(*style)};
-    delete style;
-    return ret;
+    return BladeStyles::asString(*style);
 }
 
 const BladeStyles::BladeStyle* StyleBlock::getStyle() const { 
@@ -181,13 +177,14 @@ void StyleBlock::doOnGrab() {
     auto *parentBlock{dynamic_cast<StyleBlock*>(GetParent())};
     if (!parentBlock) return;
 
-    for (auto *param : parentBlock->pStyle->getParams()) {
-        if (!(param->getType() & BladeStyles::STYLETYPE)) continue;
-        auto *styleParam{static_cast<BladeStyles::StyleParam*>(param)};
+    auto *parentStyle{parentBlock->pStyle};
+    const auto& params{parentStyle->getParams()};
+    for (size_t i{0}; i < params.size(); i++) {
+        if (!(params[i].getType() & BladeStyles::STYLETYPE)) continue;
+        if (params[i].getStyle() != pStyle) continue;
 
-        if (styleParam->getStyle() != pStyle) continue;
-        // We *are* the style, so we can ignore the return.
-        (void)styleParam->detachStyle();
+        // We *are* the style, and the reference the parent held is ours now.
+        (void)parentStyle->detachParamStyle(i);
     }
 }
 
@@ -195,7 +192,7 @@ bool StyleBlock::tryAdopt(Movable* window, wxPoint pos) {
         auto *block{dynamic_cast<StyleBlock*>(window)};
         if (!block) return false;
 
-        const BladeStyles::Param* paramToFill{nullptr};
+        std::optional<size_t> paramToFill;
 
         for (size_t i{0}; i < mParamsData.size(); i++) {
             auto& paramData{mParamsData.at(i)};
@@ -214,18 +211,17 @@ bool StyleBlock::tryAdopt(Movable* window, wxPoint pos) {
                     pos.y > paramScreenLoc.y &&
                     pos.y < paramScreenLoc.y + paramData.rectSize.y + (borderThickness() * 2)
                ) {
-                paramToFill = param;
+                paramToFill = i;
                 break;
             }
         }
 
         if (!paramToFill) return false;
-        const auto *styleParam{static_cast<const BladeStyles::StyleParam*>(paramToFill)};
 
-        const auto *paramStyle{styleParam->getStyle()};
+        const auto *paramStyle{pStyle->getParamStyle(*paramToFill)};
         if (paramStyle) return blockMap.find(paramStyle)->second->tryAdopt(window, pos);    
 
-        const_cast<BladeStyles::StyleParam*>(styleParam)->setStyle(const_cast<BladeStyles::BladeStyle*>(block->getStyle()));
+        if (!pStyle->setParam(*paramToFill, const_cast<BladeStyles::BladeStyle*>(block->getStyle()))) return false;
         block->Reparent(this);
 
         update();
@@ -279,10 +275,10 @@ void StyleBlock::collapse(bool collapse) {
 
 void StyleBlock::setScale(float val) { 
     mScale = val; 
-    for (auto *const param : pStyle->getParams()) {
-        if (!(param->getType() & BladeStyles::STYLETYPE)) continue;
+    for (const auto& param : pStyle->getParams()) {
+        if (!(param.getType() & BladeStyles::STYLETYPE)) continue;
 
-        auto blockIt{blockMap.find(static_cast<BladeStyles::StyleParam*>(param)->getStyle())};
+        auto blockIt{blockMap.find(param.getStyle())};
         if (blockIt == blockMap.end()) continue;
         blockIt->second->setScale(val);
     }
@@ -354,13 +350,13 @@ void StyleBlock::calc() {
     for (size_t i{0}; i < params.size(); i++) {
         using namespace BladeStyles;
 
-        auto *param{params.at(i)};
+        const auto& param{params.at(i)};
         auto& data{mParamsData.at(i)};
         data.colors.clear();
 
-        auto paramType{param->getType()};
-        const auto *paramStyle{static_cast<StyleParam*>(param)->getStyle()};
-        if ((paramType & STYLETYPE) && paramStyle) {
+        auto paramType{param.getType()};
+        const auto *paramStyle{paramType & STYLETYPE ? param.getStyle() : nullptr};
+        if (paramStyle) {
             data.rectSize = getInverseScale(blockMap.find(paramStyle)->second->GetSize());
         } else if (data.control) {
             data.rectSize = data.control->GetBestSize();
@@ -378,14 +374,11 @@ void StyleBlock::calc() {
         } if (paramType & FUNCTION3D) {
             data.colors.push_back(function3DColor);
 		} if (paramType & NUMBER) {
-            auto *numberParam{static_cast<NumberParam*>(param)};
-            if (!data.control) data.control = new PCUI::Numeric(this, wxID_ANY, wxEmptyString, wxDefaultSize, 0, std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max() + 1, numberParam->getNum());
+            if (!data.control) data.control = new PCUI::Numeric(this, wxID_ANY, wxEmptyString, wxDefaultSize, 0, std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max() + 1, param.getNum());
 		} if (paramType & BITS) {
-            auto *bitsParam{static_cast<BitsParam*>(param)};
-            if (!data.control) data.control = new PCUI::BitsCtrl(this, wxID_ANY, sizeof(int16_t) * CHAR_BIT, bitsParam->getBits(), wxEmptyString, wxDefaultSize);
+            if (!data.control) data.control = new PCUI::BitsCtrl(this, wxID_ANY, sizeof(int16_t) * CHAR_BIT, param.getBits(), wxEmptyString, wxDefaultSize);
 		} if (paramType & BOOL) {
-            auto *boolParam{static_cast<BoolParam*>(param)};
-            if (!data.control) data.control = new PCUI::Bool(this, wxID_ANY, boolParam->getBool());
+            if (!data.control) data.control = new PCUI::Bool(this, wxID_ANY, param.getBool());
 		} if (paramType & COLOR) {
             data.colors.push_back(colorColor);
 		} if (paramType & LAYER) {
@@ -404,7 +397,7 @@ void StyleBlock::calc() {
 
         data.textPos = drawLocation;
         drawLocation.y += internalPadding();
-        auto argTextSize{clientDC.GetTextExtent(param->name)};
+        auto argTextSize{clientDC.GetTextExtent(param.name)};
         drawLocation.y += argTextSize.y;
         if (drawLocation.x + argTextSize.x > mSize.x) mSize.x = drawLocation.x + argTextSize.x;
         if (drawLocation.x + argTextSize.x > mRectSize.x) mRectSize.x = drawLocation.x + argTextSize.x;
@@ -496,7 +489,7 @@ void StyleBlock::updateElementPos() {
                 paramData.control->SetFont(font);
                 break; }
             default:
-                const auto *style{static_cast<const BladeStyles::StyleParam*>(param)->getStyle()};
+                const auto *style{param.getStyle()};
                 auto block{blockMap.find(style)};
                 if (block == blockMap.end()) continue;
 
@@ -538,12 +531,12 @@ void StyleBlock::render(wxDC& devContext) {
 
     const auto& params{pStyle->getParams()};
     for (size_t i{0}; i < mParamsData.size(); i++) {
-        auto *param{params.at(i)};
+        const auto& param{params.at(i)};
         auto& data{mParamsData.at(i)};
         devContext.SetTextForeground(*textColor);
-        devContext.DrawText(param->name, data.textPos.x, data.textPos.y);
+        devContext.DrawText(param.name, data.textPos.x, data.textPos.y);
 
-        if (!(param->getType() & BladeStyles::STYLETYPE)) continue;
+        if (!(param.getType() & BladeStyles::STYLETYPE)) continue;
 
         auto blockBoxSize{data.rectSize};
         blockBoxSize.x = mSize.x;
@@ -572,8 +565,8 @@ void StyleBlock::render(wxDC& devContext) {
         }
         devContext.DrawRoundedRectangle(data.rectPos.x + borderThickness(), data.rectPos.y + borderThickness(), blockBoxSize.x, blockBoxSize.y, rectangeRadius());
 
-        if (param->getType() & BladeStyles::REFMASK) {
-            const auto refNum{BladeStyles::getRefFromType(param->getType())};
+        if (param.getType() & BladeStyles::REFMASK) {
+            const auto refNum{BladeStyles::getRefFromType(param.getType())};
             const auto yOffset{(data.rectSize.y - devContext.GetCharHeight()) / 2};
             devContext.SetTextForeground(*dimColor);
             devContext.DrawText(params.at(refNum - 1)->name, data.rectPos.x + borderThickness() + internalPadding(), data.rectPos.y + borderThickness() + yOffset);
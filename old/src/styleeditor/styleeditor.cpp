@@ -156,7 +156,9 @@ void createToolbox() {
             evt.Skip(false);
             if (!block->hitTest(evt.GetPosition())) return;
 
-            auto *newBlock{new PCUI::StyleBlock(blockMoveArea, toolboxScroller, new BladeStyles::BladeStyle(*block->getStyle()))};
+            auto *newStyle{block->getStyle()->clone()};
+            if (!newStyle) return;
+            auto *newBlock{new PCUI::StyleBlock(blockMoveArea, toolboxScroller, newStyle)};
 
             newBlock->collapse(block->isCollapsed());
             newBlock->setScale(scale);
@@ -20,16 +20,21 @@
  */
 
 #include <fstream>
+#include <vector>
 
 #include "appcore/interfaces.h"
 #include "log/logger.h"
 #include "pconf/pconf.h"
+#include "styles/intern.h"
 #include "styles/parse.h"
 #include "ui/frame.h"
 
 #define STYLE_FILENAME "styles.pconf"
 
 static PCUI::Frame* interface{nullptr};
+// Presets tend to reuse the same blasts, lockups, etc., so keep only one
+// copy of each.
+static BladeStyles::InternTable internTable;
 
 void StyleManager::launch(wxWindow* parent) {
     if (interface) {
@@ -52,64 +57,121 @@ StyleManager::StyleMap* StyleManager::loadStyles() {
 
     auto *styles{new StyleMap};
 
-    PConf::Section* section{nullptr};
-    while (!styleFile.eof()) {
-        section = PConf::readSection(styleFile);
-        if (!section) continue;
-        if (section->name != "STYLEPRESET") continue;
-        if (!section->label) {
-            Logger::warn("Style Preset missing name, ignoring!");
+    auto file{PConf::Document::read(styleFile)};
+
+    // Subtrees presets share are saved once as aliases, written before
+    // anything using them.
+    BladeStyles::StyleAliases aliases;
+    for (const auto& section : file.entries()) {
+        if (section.key != PConf::Key::STYLEALIAS || section.getType() != PConf::DataType::SECTION) continue;
+        if (!section.label) {
+            Logger::warn("Style Alias missing name, ignoring!");
             continue;
         }
-        if (styles->find(section->label.value()) != styles->end()) {
-            Logger::warn("Ignoring style with duplicate name: \"" + section->label.value() + "\"");
+
+        const auto *styleEntry{section.find(PConf::Key::STYLE)};
+        if (!styleEntry || !styleEntry->value) {
+            Logger::warn("Style alias entry missing style!");
             continue;
         }
 
-        std::string* styleStr{nullptr};
-        for (const auto& entry : section->entries) {
-            if (entry->value && entry->name == "STYLE") styleStr = &entry->value.value();
+        auto *style{BladeStyles::parseString(*styleEntry->value, nullptr, &aliases)};
+        if (!style) {
+            Logger::warn("Error parsing style for alias \"" + std::string{*section.label} + "\"");
+            continue;
         }
-        if (!styleStr) {
+
+        auto& alias{aliases[std::string{*section.label}]};
+        BladeStyles::BladeStyle::release(alias);
+        alias = internTable.intern(style);
+    }
+
+    for (const auto& section : file.entries()) {
+        if (section.key != PConf::Key::STYLEPRESET || section.getType() != PConf::DataType::SECTION) continue;
+        if (!section.label) {
+            Logger::warn("Style Preset missing name, ignoring!");
+            continue;
+        }
+        const std::string presetName{section.label.value()};
+        if (styles->find(presetName) != styles->end()) {
+            Logger::warn("Ignoring style with duplicate name: \"" + presetName + "\"");
+            continue;
+        }
+
+        const auto *styleEntry{section.find(PConf::Key::STYLE)};
+        if (!styleEntry || !styleEntry->value) {
             Logger::warn("Style entry missing style!");
             continue;
         }
 
-        auto *style{BladeStyles::parseString(*styleStr)};
+        auto *style{BladeStyles::parseString(*styleEntry->value, nullptr, &aliases)};
         if (!style) {
-            Logger::warn("Error parsing style for preset \"" + section->name + "\"");
+            Logger::warn("Error parsing style for preset \"" + presetName + "\"");
             continue;
         }
 
-        Preset stylePreset{
-            .name = section->label.value(),
-            .style = style,
-        };
-        styles->insert({ stylePreset.name, stylePreset });
+        internTable.internParams(*style);
+
+        // Constructed in place, a copy would delete the style on the way.
+        auto& stylePreset{(*styles)[presetName]};
+        stylePreset.name = presetName;
+        stylePreset.style = style;
     }
 
     styleFile.close();
+    for (const auto& [ aliasName, alias ] : aliases) BladeStyles::BladeStyle::release(alias);
+    // Drop anything only previously loaded styles were using
+    internTable.purge();
 
     return styles;
 }
 
 void StyleManager::saveStyles(const StyleManager::StyleMap& styles) {
-    std::ofstream styleFile{RESOURCEPATH STYLE_FILENAME};
-    if (!styleFile.is_open()) {
-        Logger::info("Could not open styles config file.");
-        return;
+    std::vector<const BladeStyles::BladeStyle*> presetStyles;
+    presetStyles.reserve(styles.size());
+    for (const auto& [ styleName, style ] : styles) presetStyles.push_back(style.style);
+
+    // Edits copy what they change, so whatever presets still share is
+    // still the same node and gets aliased.
+    const auto aliased{BladeStyles::asAliasedStrings(presetStyles)};
+
+    PConf::Writer writer;
+    for (const auto& [ aliasName, aliasStr ] : aliased.aliases) {
+        const PConf::Entry styleEntry{
+            .name = "STYLE",
+            .value = aliasStr,
+        };
+        const PConf::Entry section{
+            .name = "STYLEALIAS",
+            .label = aliasName,
+            .type = PConf::DataType::SECTION,
+            .entries{&styleEntry, 1},
+        };
+        writer.writeSection(section);
     }
 
+    auto styleStrIt{aliased.styles.begin()};
     for (const auto& [ styleName, style ] : styles) {
-        auto *section{new PConf::Section};
-        section->name = "STYLEPRESET";
-        section->label = style.name;
-        auto *styleEntry{new PConf::Entry};
-        styleEntry->name = "STYLE";
-        styleEntry->value = BladeStyles::asString(*style.style);
-        section->entries.push_back(styleEntry);
-        PConf::writeSection(styleFile, *section);
+        const auto& styleStr{*styleStrIt++};
+        if (!styleStr) {
+            Logger::warn("Could not convert style \"" + style.name + "\" to string, skipping!");
+            continue;
+        }
+
+        const PConf::Entry styleEntry{
+            .name = "STYLE",
+            .value = styleStr.value(),
+        };
+        const PConf::Entry section{
+            .name = "STYLEPRESET",
+            .label = style.name,
+            .type = PConf::DataType::SECTION,
+            .entries{&styleEntry, 1},
+        };
+        writer.writeSection(section);
     }
 
-    styleFile.close();
+    if (!writer.save(RESOURCEPATH STYLE_FILENAME)) {
+        Logger::info("Could not save styles config file.");
+    }
 }
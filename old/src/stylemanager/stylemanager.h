@@ -28,7 +28,7 @@
 namespace StyleManager {
 
 struct Preset {
-  ~Preset() { delete style; }
+  ~Preset() { BladeStyles::BladeStyle::release(style); }
 
   std::string name;
   BladeStyles::BladeStyle *style{nullptr};
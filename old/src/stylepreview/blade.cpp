@@ -20,14 +20,69 @@
  */
 
 
-const std::vector<BladeStyles::StylePreview::BladeEffect> &BladeStyles::StylePreview::Blade::getEffects() const {
+#include <algorithm>
+#include <iterator>
 
+std::span<const BladeStyles::StylePreview::BladeEffect> BladeStyles::StylePreview::Blade::getEffects() const {
+    return { mEffects.data(), mNumEffects };
 }
 
 bool BladeStyles::StylePreview::Blade::isOn() const {
+    return mOn;
+}
+
+void BladeStyles::StylePreview::Blade::doEffect(Effect effect, int32_t location, int32_t) {
+    switch (effect) {
+        case Effect::ON:
+        case Effect::FAST_ON:
+        case Effect::IGNITION:
+            mOn = true;
+            break;
+        case Effect::OFF:
+        case Effect::FAST_OFF:
+        case Effect::RETRACTION:
+            mOn = false;
+            break;
+        default:
+            break;
+    }
 
+    if (mNumEffects == MAX_EFFECTS) {
+        std::move(std::next(mEffects.begin()), mEffects.end(), mEffects.begin());
+        mNumEffects--;
+    }
+    mEffects[mNumEffects++] = {
+        .type = effect,
+        .startMicros = mNowMicros,
+        .location = location,
+    };
 }
 
-void BladeStyles::StylePreview::Blade::doEffect(Effect, int32_t location, int32_t wavNum) {
+bool BladeStyles::StylePreview::Blade::queueEffect(Effect effect, int32_t location, int32_t wavNum) {
+    return mEffectQueue.push({ effect, location, wavNum });
+}
+
+void BladeStyles::StylePreview::Blade::update(uint64_t nowMicros) {
+    mNowMicros = nowMicros;
+    mFrame.resize(numLeds);
+
+    // Effects are in start order, so expired ones are always at the front
+    size_t numExpired{0};
+    while (numExpired < mNumEffects && nowMicros - mEffects[numExpired].startMicros > EFFECT_LIFETIME_MICROS) numExpired++;
+    if (numExpired) {
+        std::move(std::next(mEffects.begin(), static_cast<ptrdiff_t>(numExpired)), std::next(mEffects.begin(), static_cast<ptrdiff_t>(mNumEffects)), mEffects.begin());
+        mNumEffects -= numExpired;
+    }
+
+    while (const auto queued{mEffectQueue.pop()}) {
+        doEffect(queued->type, queued->location, queued->wavNum);
+    }
+}
+
+uint64_t BladeStyles::StylePreview::Blade::getTimeMicros() const {
+    return mNowMicros;
+}
 
+uint64_t BladeStyles::StylePreview::Blade::getTimeMS() const {
+    return mNowMicros / 1000;
 }
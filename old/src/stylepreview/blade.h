@@ -19,9 +19,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "proffieconstructs/random.h"
 #include "styles/elements/effects.h"
+#include "styles/ledframe.h"
+#include "utility/spscqueue.h"
+#include <array>
 #include <cstdint>
-#include <vector>
+#include <span>
 
 namespace BladeStyles::StylePreview {
 
@@ -40,17 +44,77 @@ public:
     // uint32_t getAngle1() const;
 
     // Effects are cleared out 7s (7000000us) after occurring
-    // Maximum of 10 effects in "stack" (Make this a deque?)
-    [[nodiscard]] const std::vector<BladeEffect>& getEffects() const;
+    // Maximum of 10 effects in "stack"
+    //
+    // Oldest first. The view is only valid until the next update()/doEffect()
+    [[nodiscard]] std::span<const BladeEffect> getEffects() const;
 
     [[nodiscard]] bool isOn() const;
 
+    /**
+     * Apply an effect immediately, must be called from the render thread.
+     */
     void doEffect(Effect, int32_t location, int32_t wavNum);
+    /**
+     * Queue an effect to be applied on the next update(). This may be
+     * called from one other thread (i.e. UI) while rendering.
+     *
+     * @return false if too many effects are already pending
+     */
+    bool queueEffect(Effect, int32_t location, int32_t wavNum);
+
+    /**
+     * Advance the blade's clock, apply queued effects, and expire old ones.
+     * Effects are timestamped with the time of the last update.
+     */
+    void update(uint64_t nowMicros);
+    /**
+     * Styles must use these instead of the system clock, so every element
+     * sees the same time for a frame and rendering is reproducible.
+     */
+    [[nodiscard]] uint64_t getTimeMicros() const;
+    [[nodiscard]] uint64_t getTimeMS() const;
+
+    /**
+     * The blade's LED colors, sized to numLeds as of the last update().
+     * Allocated once per blade and rendered into in place each frame.
+     */
+    [[nodiscard]] LedFrame& getFrame() { return mFrame; }
+    [[nodiscard]] const LedFrame& getFrame() const { return mFrame; }
+
+    /**
+     * Styles must use this for randomness. Each blade has its own
+     * generator, so a given seed always renders the same frames.
+     */
+    [[nodiscard]] ProffieUtils::Random& getRandom() { return mRandom; }
 
     static constexpr auto PERCENT_100{100};
     int32_t batteryLevel{PERCENT_100};
     static constexpr auto WS2811_NUM_LEDS{144};
     int32_t numLeds{WS2811_NUM_LEDS};
+
+    static constexpr size_t MAX_EFFECTS{10};
+    static constexpr uint64_t EFFECT_LIFETIME_MICROS{7000000};
+
+private:
+    struct QueuedEffect {
+        Effect type;
+        int32_t location;
+        int32_t wavNum;
+    };
+    static constexpr size_t EFFECT_QUEUE_SIZE{16};
+
+    // With so few effects, keeping them packed in order is cheaper than
+    // wrapping, and lets styles read them as a plain span.
+    std::array<BladeEffect, MAX_EFFECTS> mEffects{};
+    size_t mNumEffects{0};
+    Utility::SPSCQueue<QueuedEffect, EFFECT_QUEUE_SIZE> mEffectQueue;
+
+    bool mOn{false};
+    uint64_t mNowMicros{0};
+
+    LedFrame mFrame;
+    ProffieUtils::Random mRandom;
 };
 
 } // namespace BladeStyles::StylePreview
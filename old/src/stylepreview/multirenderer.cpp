@@ -0,0 +1,108 @@
+#include "multirenderer.h"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * stylepreview/multirenderer.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+using namespace BladeStyles;
+
+StylePreview::MultiRenderer::MultiRenderer(uint32_t numThreads) {
+    if (numThreads == 0) numThreads = std::max(std::thread::hardware_concurrency(), 1U);
+
+    // The thread calling tick() does its share too
+    mWorkers.reserve(numThreads - 1);
+    for (uint32_t i{1}; i < numThreads; i++) mWorkers.emplace_back(&MultiRenderer::workerLoop, this);
+}
+
+StylePreview::MultiRenderer::~MultiRenderer() {
+    {
+        std::scoped_lock lock{mLock};
+        mStopping = true;
+    }
+    mStartCondition.notify_all();
+    for (auto& worker : mWorkers) worker.join();
+}
+
+std::optional<size_t> StylePreview::MultiRenderer::addBlade(BladeStyle* style, int32_t numLeds) {
+    if (!style) return std::nullopt;
+    if (std::find(mStyles.begin(), mStyles.end(), style) != mStyles.end()) return std::nullopt;
+
+    auto renderer{std::make_unique<Renderer>(numLeds)};
+    if (!renderer->setStyle(style)) return std::nullopt;
+
+    mRenderers.push_back(std::move(renderer));
+    mStyles.push_back(style);
+    return mRenderers.size() - 1;
+}
+
+void StylePreview::MultiRenderer::clear() {
+    mRenderers.clear();
+    mStyles.clear();
+}
+
+bool StylePreview::MultiRenderer::queueEffect(Effect effect, int32_t location, int32_t wavNum) {
+    bool queued{true};
+    for (auto& renderer : mRenderers) queued &= renderer->queueEffect(effect, location, wavNum);
+    return queued;
+}
+
+void StylePreview::MultiRenderer::tick(uint64_t deltaMicros) {
+    mDeltaMicros = deltaMicros;
+    mNextBlade = 0;
+
+    {
+        std::scoped_lock lock{mLock};
+        mFrameNum++;
+        mBusyWorkers = mWorkers.size();
+    }
+    mStartCondition.notify_all();
+
+    renderBlades();
+
+    std::unique_lock lock{mLock};
+    mDoneCondition.wait(lock, [this]() { return mBusyWorkers == 0; });
+}
+
+void StylePreview::MultiRenderer::workerLoop() {
+    uint64_t lastFrame{0};
+    while (true) {
+        {
+            std::unique_lock lock{mLock};
+            mStartCondition.wait(lock, [&]() { return mStopping || mFrameNum != lastFrame; });
+            if (mStopping) return;
+            lastFrame = mFrameNum;
+        }
+
+        renderBlades();
+
+        {
+            std::scoped_lock lock{mLock};
+            mBusyWorkers--;
+        }
+        mDoneCondition.notify_one();
+    }
+}
+
+void StylePreview::MultiRenderer::renderBlades() {
+    for (auto idx{mNextBlade++}; idx < mRenderers.size(); idx = mNextBlade++) {
+        mRenderers[idx]->tick(mDeltaMicros);
+    }
+}
+
@@ -0,0 +1,104 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * stylepreview/multirenderer.h
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "stylepreview/renderer.h"
+
+namespace BladeStyles::StylePreview {
+
+/**
+ * Renders many blades in lockstep, e.g. every blade of every preset in a
+ * bank, for previewing side by side.
+ *
+ * Each blade is its own Renderer with its own style, and blades are
+ * handed out one at a time to a pool of threads each tick(), so a frame
+ * takes about as long as the slowest blade once there are enough cores.
+ */
+class MultiRenderer {
+public:
+    /**
+     * @param numThreads threads to render with, including the one calling
+     * tick(). 0 uses one per core.
+     */
+    explicit MultiRenderer(uint32_t numThreads = 0);
+    MultiRenderer(const MultiRenderer&) = delete;
+    MultiRenderer& operator=(const MultiRenderer&) = delete;
+    ~MultiRenderer();
+
+    /**
+     * Add a blade rendering style. The blade keeps a reference to the
+     * style, which must not be given to any other blade, since styles keep
+     * per-frame state.
+     *
+     * @return the index of the new blade, or nullopt if style can't be
+     * rendered or is already used by another blade
+     */
+    std::optional<size_t> addBlade(BladeStyle* style, int32_t numLeds = Blade::WS2811_NUM_LEDS);
+    void clear();
+
+    [[nodiscard]] size_t getNumBlades() const { return mRenderers.size(); }
+    [[nodiscard]] Renderer& getRenderer(size_t idx) { return *mRenderers[idx]; }
+    [[nodiscard]] const Renderer& getRenderer(size_t idx) const { return *mRenderers[idx]; }
+
+    /**
+     * Queue effect on every blade.
+     * Safe to call from one thread other than the one calling tick()
+     *
+     * @return false if any blade had too many effects pending
+     */
+    bool queueEffect(Effect effect, int32_t location = 0, int32_t wavNum = 0);
+
+    /**
+     * Advance every blade by deltaMicros and render one frame of each,
+     * returning once all are done.
+     */
+    void tick(uint64_t deltaMicros);
+
+private:
+    void workerLoop();
+    void renderBlades();
+
+    // Renderers aren't movable (the effect queue is atomic)
+    std::vector<std::unique_ptr<Renderer>> mRenderers;
+    std::vector<BladeStyle*> mStyles;
+
+    uint64_t mDeltaMicros{0};
+    std::atomic<size_t> mNextBlade{0};
+
+    std::vector<std::thread> mWorkers;
+    std::mutex mLock;
+    std::condition_variable mStartCondition;
+    std::condition_variable mDoneCondition;
+    uint64_t mFrameNum{0};
+    size_t mBusyWorkers{0};
+    bool mStopping{false};
+};
+
+} // namespace BladeStyles::StylePreview
+
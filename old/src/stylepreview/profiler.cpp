@@ -0,0 +1,147 @@
+#include "profiler.h"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * stylepreview/profiler.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include <string_view>
+#include <utility>
+
+#include "styles/bladestyle.h"
+
+using namespace BladeStyles;
+
+StylePreview::Profiler::~Profiler() { stop(); }
+
+bool StylePreview::Profiler::start() {
+    if (active && active != this) return false;
+    active = this;
+    return true;
+}
+
+void StylePreview::Profiler::stop() {
+    if (active == this) active = nullptr;
+    mStack.clear();
+}
+
+void StylePreview::Profiler::reset() {
+    mEntries.clear();
+    mRoots.clear();
+    mStack.clear();
+}
+
+void StylePreview::Profiler::Scope::begin(std::span<const BladeStyle* const> path, const char* method) {
+    for (const auto *style : path) mProfiler->enter(style, method);
+    mDepth = path.size();
+    mStart = std::chrono::steady_clock::now();
+}
+
+void StylePreview::Profiler::Scope::end() {
+    const auto nanos{std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mStart).count()};
+    for (size_t idx{0}; idx < mDepth; idx++) mProfiler->exit(static_cast<uint64_t>(nanos));
+}
+
+void StylePreview::Profiler::enter(const BladeStyle* style, const char* method) {
+    const auto parent{mStack.empty() ? ROOT : mStack.back()};
+    auto& siblings{parent == ROOT ? mRoots : mEntries[parent].children};
+
+    const auto entryIt{std::find_if(siblings.begin(), siblings.end(), [&](uint32_t idx) {
+        // The same method name can come from different string literals
+        return mEntries[idx].style == style && std::string_view{mEntries[idx].method} == method;
+    })};
+    if (entryIt != siblings.end()) {
+        mStack.push_back(*entryIt);
+        return;
+    }
+
+    // Params of the same type would otherwise be indistinguishable
+    std::string label{style->osName};
+    if (parent != ROOT && mEntries[parent].style != style) {
+        const auto& params{mEntries[parent].style->getParams()};
+        for (size_t paramIdx{0}; paramIdx < params.size(); paramIdx++) {
+            if (!(params[paramIdx].getType() & STYLETYPE)) continue;
+            if (params[paramIdx].getStyle() != style) continue;
+            label += '[' + std::to_string(paramIdx) + ']';
+            break;
+        }
+    }
+    label += "::";
+    label += method;
+
+    const auto idx{static_cast<uint32_t>(mEntries.size())};
+    siblings.push_back(idx);
+    mEntries.push_back({
+        .style = style,
+        .method = method,
+        .label = std::move(label),
+        .parent = parent,
+        .children = {},
+    });
+    mStack.push_back(idx);
+}
+
+void StylePreview::Profiler::exit(uint64_t nanos) {
+    // stop() may have happened mid-call
+    if (mStack.empty()) return;
+
+    auto& entry{mEntries[mStack.back()]};
+    entry.calls++;
+    entry.totalNanos += nanos;
+    mStack.pop_back();
+    if (entry.parent != ROOT) mEntries[entry.parent].childNanos += nanos;
+}
+
+std::string StylePreview::Profiler::getPath(uint32_t entry) const {
+    std::string path{mEntries[entry].label};
+    for (auto parent{mEntries[entry].parent}; parent != ROOT; parent = mEntries[parent].parent) {
+        path.insert(0, mEntries[parent].label + ';');
+    }
+    return path;
+}
+
+void StylePreview::Profiler::writeFoldedStacks(std::ostream& out) const {
+    for (uint32_t idx{0}; idx < mEntries.size(); idx++) {
+        const auto& entry{mEntries[idx]};
+        const auto selfNanos{entry.totalNanos - std::min(entry.childNanos, entry.totalNanos)};
+        if (selfNanos == 0) continue;
+        out << getPath(idx) << ' ' << selfNanos << '\n';
+    }
+}
+
+void StylePreview::Profiler::writeTable(std::ostream& out) const {
+    std::vector<uint32_t> order(mEntries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](uint32_t lhs, uint32_t rhs) {
+        return mEntries[lhs].totalNanos > mEntries[rhs].totalNanos;
+    });
+
+    out << std::setw(12) << "Calls" << std::setw(16) << "Total (ns)" << std::setw(16) << "Self (ns)" << std::setw(12) << "ns/Call" << "  Path\n";
+    for (const auto idx : order) {
+        const auto& entry{mEntries[idx]};
+        const auto selfNanos{entry.totalNanos - std::min(entry.childNanos, entry.totalNanos)};
+        out << std::setw(12) << entry.calls
+            << std::setw(16) << entry.totalNanos
+            << std::setw(16) << selfNanos
+            << std::setw(12) << (entry.calls ? entry.totalNanos / entry.calls : 0)
+            << "  " << getPath(idx) << '\n';
+    }
+}
+
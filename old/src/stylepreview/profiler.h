@@ -0,0 +1,144 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * stylepreview/profiler.h
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace BladeStyles {
+
+class BladeStyle;
+
+namespace StylePreview {
+
+/**
+ * Records how long each element of a style takes to evaluate, for finding
+ * what makes a preview slow.
+ *
+ * Only evaluation on the thread which called start() is recorded, and
+ * nothing is recorded unless a Profiler is started, which costs one
+ * inlined thread-local check per call. Only calls covering the whole blade
+ * (run(), getInts(), render(), etc.) are profiled, per-LED calls count
+ * toward whatever made them.
+ *
+ * Calls are grouped by their path through the tree, with the param index
+ * of each element, as "StylePtr::run;Bump[0]::run;Int[1]::getInt", so the
+ * same element used in two places shows up twice.
+ */
+class Profiler {
+public:
+    Profiler() = default;
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+    ~Profiler();
+
+    /**
+     * Start recording on this thread. Only one Profiler can record on a
+     * thread at a time.
+     *
+     * @return false if another Profiler is already recording
+     */
+    bool start();
+    void stop();
+    void reset();
+
+    /**
+     * Write one line per path with its self time in nanoseconds.
+     * This is the "folded stacks" format used by flamegraph.pl, speedscope,
+     * etc.
+     */
+    void writeFoldedStacks(std::ostream&) const;
+    /**
+     * Write a table of every path, heaviest total time first.
+     */
+    void writeTable(std::ostream&) const;
+
+    /**
+     * Records the enclosing call, if a Profiler is recording on this thread.
+     */
+    class Scope {
+    public:
+        Scope(const BladeStyle* style, const char* method) :
+            mProfiler(active) {
+            if (mProfiler) [[unlikely]] begin({ &style, 1 }, method);
+        }
+        /**
+         * Record the enclosing call as a call to each style in path, outermost
+         * first, for a caller that isn't the styles themselves (i.e. the
+         * bytecode interpreter) to keep the tree path.
+         */
+        Scope(std::span<const BladeStyle* const> path, const char* method) :
+            mProfiler(path.empty() ? nullptr : active) {
+            if (mProfiler) [[unlikely]] begin(path, method);
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope() {
+            if (mProfiler) [[unlikely]] end();
+        }
+
+    private:
+        void begin(std::span<const BladeStyle* const> path, const char* method);
+        void end();
+
+        Profiler* mProfiler;
+        size_t mDepth{0};
+        std::chrono::steady_clock::time_point mStart;
+    };
+
+private:
+    struct Entry {
+        const BladeStyle* style;
+        const char* method;
+        std::string label;
+        uint32_t parent;
+        std::vector<uint32_t> children;
+
+        uint64_t calls{0};
+        uint64_t totalNanos{0};
+        uint64_t childNanos{0};
+    };
+    static constexpr uint32_t ROOT{UINT32_MAX};
+    // The Profiler recording on this thread, if any
+    static inline thread_local Profiler* active{nullptr};
+
+    void enter(const BladeStyle*, const char* method);
+    void exit(uint64_t nanos);
+
+    [[nodiscard]] std::string getPath(uint32_t entry) const;
+
+    std::vector<Entry> mEntries;
+    std::vector<uint32_t> mRoots;
+    std::vector<uint32_t> mStack;
+};
+
+} // namespace StylePreview
+
+} // namespace BladeStyles
+
+/**
+ * Profile the rest of the enclosing element method.
+ */
+#define PROFILE_STYLE(method) const BladeStyles::StylePreview::Profiler::Scope profileScope{this, method}
+
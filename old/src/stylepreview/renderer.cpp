@@ -0,0 +1,108 @@
+#include "renderer.h"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * stylepreview/renderer.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include "styles/elements/colorstyles.h"
+#include "styles/elements/functions.h"
+
+using namespace BladeStyles;
+
+StylePreview::Renderer::Renderer(int32_t numLeds) {
+    mBlade.numLeds = numLeds;
+    mBlade.update(mNowMicros);
+    mFrameRGB8.resize(static_cast<size_t>(numLeds) * 3);
+}
+
+StylePreview::Renderer::~Renderer() {
+    // Unbind the functions before the style they belong to can go away.
+    mProgram.reset();
+    BladeStyle::release(mStyle);
+}
+
+bool StylePreview::Renderer::setStyle(BladeStyle* style) {
+    if (style && !(style->getType() & (WRAPPER | COLOR | LAYER | FUNCTION))) return false;
+
+    // The old program has to let go of its functions before they might
+    // be bound again.
+    mProgram.reset();
+    if (style) {
+        style->unshare();
+        style->retain();
+    }
+    BladeStyle::release(mStyle);
+    mStyle = style;
+    if (style) mProgram.reset(Bytecode::Program::compile(style));
+    return true;
+}
+
+bool StylePreview::Renderer::queueEffect(Effect effect, int32_t location, int32_t wavNum) {
+    return mBlade.queueEffect(effect, location, wavNum);
+}
+
+void StylePreview::Renderer::tick(uint64_t deltaMicros) {
+    mNowMicros += deltaMicros;
+    mBlade.update(mNowMicros);
+
+    auto& frame{mBlade.getFrame()};
+    // A bare layer paints over whatever is there, so give it black to paint on.
+    if (!mStyle || (mStyle->getType() & LAYER)) frame.fill(ColorData{});
+    if (mStyle && (mStyle->getType() & FUNCTION)) {
+        renderFunction(frame);
+    } else if (mProgram) {
+        mProgram->render(mBlade, frame);
+    } else if (mStyle) {
+        auto* color{static_cast<ColorStyle*>(mStyle)};
+        color->run(mBlade);
+        color->render(frame);
+    }
+
+    // Colors are on a 0-32768 scale
+    constexpr auto TO_8BIT_SHIFT{7};
+    constexpr uint32_t MAX_8BIT{255};
+    mFrameRGB8.resize(static_cast<size_t>(frame.size()) * 3);
+    const auto red{frame.red()};
+    const auto green{frame.green()};
+    const auto blue{frame.blue()};
+    auto outIt{mFrameRGB8.begin()};
+    for (size_t led{0}; led < red.size(); led++) {
+        *outIt++ = static_cast<uint8_t>(std::min(red[led] >> TO_8BIT_SHIFT, MAX_8BIT));
+        *outIt++ = static_cast<uint8_t>(std::min(green[led] >> TO_8BIT_SHIFT, MAX_8BIT));
+        *outIt++ = static_cast<uint8_t>(std::min(blue[led] >> TO_8BIT_SHIFT, MAX_8BIT));
+    }
+}
+
+void StylePreview::Renderer::renderFunction(LedFrame& frame) {
+    mFunctionValues.resize(frame.size());
+    if (mProgram) {
+        mProgram->evaluate(mBlade, mFunctionValues);
+    } else {
+        auto* function{static_cast<FunctionStyle*>(mStyle)};
+        function->run(mBlade);
+        function->getInts(mFunctionValues);
+    }
+
+    constexpr int32_t MAX_LEVEL{32768};
+    for (int32_t led{0}; led < frame.size(); led++) {
+        const auto level{static_cast<uint32_t>(std::clamp(mFunctionValues[led], 0, MAX_LEVEL))};
+        frame.setColor(led, { .red = level, .green = level, .blue = level });
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * stylepreview/renderer.h
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "stylepreview/blade.h"
+#include "styles/bladestyle.h"
+#include "styles/bytecode.h"
+#include "styles/ledframe.h"
+
+namespace BladeStyles {
+
+namespace StylePreview {
+
+/**
+ * Renders a style against a simulated blade, with no UI involved.
+ *
+ * Time only advances when tick() is called, so a sequence of ticks and
+ * effects always renders the same frames, as fast as the style allows.
+ */
+class Renderer {
+public:
+    explicit Renderer(int32_t numLeds = Blade::WS2811_NUM_LEDS);
+    Renderer(const Renderer&) = delete;
+    Renderer& operator=(const Renderer&) = delete;
+    ~Renderer();
+
+    /**
+     * Set the style to render. The Renderer keeps a reference to the style
+     * until another is set or it is destroyed, and compiles it to
+     * bytecode, so it must not be edited while set.
+     * Any subtrees it shares with other styles are copied first.
+     *
+     * A function style is shown as the brightness it gives each LED, like
+     * Mix<F, Black, White>.
+     *
+     * @return false if style is not a color/layer/wrapper/function style
+     */
+    bool setStyle(BladeStyle* style);
+
+    /**
+     * Effects are applied at the start of the next tick()
+     * Safe to call from one thread other than the one calling tick()
+     *
+     * @return false if too many effects are already pending
+     */
+    bool queueEffect(Effect effect, int32_t location = 0, int32_t wavNum = 0);
+
+    /**
+     * Advance the clock by deltaMicros and render one frame.
+     */
+    void tick(uint64_t deltaMicros);
+
+    [[nodiscard]] Blade& getBlade() { return mBlade; }
+    [[nodiscard]] uint64_t getTimeMicros() const { return mNowMicros; }
+
+    [[nodiscard]] const LedFrame& getFrame() const { return mBlade.getFrame(); }
+    /**
+     * The last frame as packed 8-bit RGB, 3 bytes per LED.
+     */
+    [[nodiscard]] std::span<const uint8_t> getFrameRGB8() const { return mFrameRGB8; }
+
+private:
+    void renderFunction(LedFrame&);
+
+    Blade mBlade;
+    BladeStyle* mStyle{nullptr};
+    std::unique_ptr<Bytecode::Program> mProgram;
+    uint64_t mNowMicros{0};
+
+    std::vector<int32_t> mFunctionValues;
+
+    std::vector<uint8_t> mFrameRGB8;
+};
+
+} // namespace StylePreview
+
+} // namespace BladeStyles
+
@@ -20,6 +20,7 @@
  */
 
 #include "log/logger.h"
+#include "styles/stylepool.h"
 #include "styles/elements/args.h"
 #include "styles/elements/builtin.h"
 #include "styles/elements/colors.h"
@@ -34,92 +35,115 @@
 #include <algorithm>
 #include <cstdint>
 #include <limits>
+#include <unordered_map>
+#include <utility>
 #include <variant>
 
 using namespace BladeStyles;
 
+static const std::unordered_map<std::string_view, StyleInfo>& getRegistry();
+
 BladeStyle::BladeStyle(
         const char* osName, 
         const char* humanName, 
         const StyleType type,
-        const std::vector<Param*>& params) :
+        const std::vector<Param>& params) :
     osName(osName),
     humanName(humanName),
     pType(type),
     mParams(params) {}
 
-BladeStyle::BladeStyle(const BladeStyle& other) :
-    osName(other.osName),
-    humanName(other.humanName),
-    pType(other.pType) {
-    mParams.clear();
-
-    for (auto *const param : other.mParams) {
-        Param* newParam{nullptr};
-        switch (param->getType() & FLAGMASK) {
-            case NUMBER:
-                newParam = new NumberParam(param->name, static_cast<const NumberParam*>(param)->getNum(), param->getType());
-                break;
-            case BITS:
-                newParam = new BitsParam(param->name, static_cast<const BitsParam*>(param)->getBits(), param->getType());
-                break;
-            case BOOL:
-                newParam = new BoolParam(param->name, static_cast<const BoolParam*>(param)->getBool(), param->getType());
-                break;
-            default:
-                const auto *newParamStyle{static_cast<const StyleParam*>(param)->getStyle()};
-                newParam = new StyleParam(param->name, param->getType(), newParamStyle ? new BladeStyle(*newParamStyle) : nullptr);
-                break;
-        }
-        mParams.push_back(newParam);
-    }
+BladeStyle::~BladeStyle() {
+    for (auto& param : mParams) param.releaseStyle();
 }
 
-BladeStyle::~BladeStyle() {
-    for (auto *param : mParams) {
-         delete param;
+void* BladeStyle::operator new(size_t size) { return StylePool::allocate(size); }
+void BladeStyle::operator delete(void* ptr, size_t size) { StylePool::deallocate(ptr, size); }
+
+StyleType BladeStyle::getType() const { return pType; }
+
+BladeStyle* BladeStyle::clone() const {
+    // Going through the generator gets the right type, with fresh state.
+    const auto generator{get(osName)};
+    if (!generator) {
+        Logger::error("clone(): Unknown style " + std::string(osName));
+        return nullptr;
+    }
+
+    auto *ret{generator({})};
+    if (!ret) return nullptr;
+
+    for (auto& param : ret->mParams) param.releaseStyle();
+    ret->mParams = mParams;
+    for (auto& param : ret->mParams) {
+        if ((param.mType & STYLETYPE) && param.mStyle && !param.mBorrowed) param.mStyle->retain();
     }
+    ret->comment = comment;
+    return ret;
 }
 
-StyleType BladeStyle::getType() const { return pType; }
+void BladeStyle::retain() const { mRefs.fetch_add(1, std::memory_order_relaxed); }
+
+void BladeStyle::release(const BladeStyle* style) {
+    if (!style) return;
+    if (style->mRefs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete style;
+}
+
+bool BladeStyle::isShared() const { return mRefs.load(std::memory_order_acquire) > 1; }
+
+const StyleInfo* BladeStyles::findStyle(std::string_view styleName) {
+    const auto& registry{getRegistry()};
+    const auto styleIt{registry.find(styleName)};
+    return styleIt == registry.end() ? nullptr : &styleIt->second;
+}
 
-StyleGenerator BladeStyles::get(const std::string& styleName) {
-    StyleGenerator gen{nullptr};
-
-    gen = FunctionStyle::get(styleName);
-    if (gen) return gen;
-    gen = TimeFunctionStyle::get(styleName);
-    if (gen) return gen;
-    gen = ColorStyle::get(styleName);
-    if (gen) return gen;
-    gen = FixedColorStyle::get(styleName);
-    if (gen) return gen;
-    gen = BuiltIn::get(styleName);
-    if (gen) return gen;
-    gen = ArgumentStyle::get(styleName);
-    if (gen) return gen;
-    gen = LockupTypeStyle::get(styleName);
-    if (gen) return gen;
-    gen = EffectStyle::get(styleName);
-    if (gen) return gen;
-    gen = TransitionStyle::get(styleName);
-    if (gen) return gen;
-    gen = LayerStyle::get(styleName);
-    if (gen) return gen;
-    gen = WrapperStyle::get(styleName);
-    if (gen) return gen;
-
-    return nullptr;
+StyleGenerator BladeStyles::get(std::string_view styleName) {
+    const auto *info{findStyle(styleName)};
+    return info ? info->generator : nullptr;
+}
+
+static const std::unordered_map<std::string_view, StyleInfo>& getRegistry() {
+    // Built on first use, the maps it's built from are statics in other
+    // translation units so may not exist yet during static init.
+    static const auto registry{[] {
+        const std::pair<const StyleMap&, StyleType> categories[]{
+            { FunctionStyle::getMap(), FUNCTION },
+            { TimeFunctionStyle::getMap(), TIMEFUNC },
+            { ColorStyle::getMap(), COLOR },
+            { FixedColorStyle::getMap(), COLOR | FIXEDCOLOR },
+            { BuiltIn::getMap(), BUILTIN },
+            { ArgumentStyle::getMap(), ARGUMENT },
+            { LockupTypeStyle::getMap(), LOCKUPTYPE },
+            { EffectStyle::getMap(), EFFECT },
+            { TransitionStyle::getMap(), TRANSITION },
+            { LayerStyle::getMap(), LAYER },
+            { WrapperStyle::getMap(), WRAPPER },
+        };
+
+        size_t numStyles{0};
+        for (const auto& [ map, _ ] : categories) numStyles += map.size();
+
+        std::unordered_map<std::string_view, StyleInfo> ret;
+        ret.reserve(numStyles);
+        // If a name is in more than one map, the first wins.
+        for (const auto& [ map, type ] : categories) {
+            for (const auto& [ name, generator ] : map) {
+                ret.emplace(name, StyleInfo{ .generator = generator, .type = type });
+            }
+        }
+        return ret;
+    }()};
+    return registry;
 }
 
 bool BladeStyle::validateParams(std::string* err) const {
-    for (auto *const param : mParams) {
-        if (!(param->getType() & STYLETYPE)) continue;
+    for (const auto& param : mParams) {
+        if (!(param.getType() & STYLETYPE)) continue;
 
-        if (!static_cast<const StyleParam*>(param)->getStyle()) {
+        if (!param.getStyle()) {
             if (err) {
                 (*err) = "Empty parameter: \"";
-                (*err) += param->name;
+                (*err) += param.name;
                 (*err) += '"';
             }
             return false;
@@ -129,7 +153,7 @@ bool BladeStyle::validateParams(std::string* err) const {
 }
 
 bool BladeStyle::setParams(const std::vector<ParamValue>& inParams) {
-    if (inParams.size() > mParams.size() && !(mParams.back()->getType() & VARIADIC)) return false;
+    if (inParams.size() > mParams.size() && !(mParams.back().getType() & VARIADIC)) return false;
 
     for (size_t i{0}; i < inParams.size(); i++) {
         if (i < mParams.size()) setParam(i, inParams.at(i));
@@ -143,33 +167,35 @@ bool BladeStyle::setParam(size_t idx, const ParamValue& inParam) {
     if (idx >= mParams.size()) return false;
     auto& param{mParams.at(idx)};
 
-    if (std::holds_alternative<BladeStyle*>(inParam)) {
-        auto *inStyle{std::get<BladeStyle*>(inParam)};
-        if (!(inStyle->pType & param->getType() & FLAGMASK)) return false;
-        static_cast<StyleParam*>(param)->setStyle(inStyle);
+    if (!std::holds_alternative<int32_t>(inParam)) {
+        const auto borrowed{std::holds_alternative<BorrowedStyle>(inParam)};
+        auto *inStyle{borrowed ? 
+            const_cast<BladeStyle*>(std::get<BorrowedStyle>(inParam).style) : 
+            std::get<BladeStyle*>(inParam)};
+        if (!inStyle || !(inStyle->pType & param.getType() & FLAGMASK)) return false;
+
+        if (param.mStyle == inStyle && !param.mBorrowed) {
+            // Already holding a reference, so don't need another
+            if (!borrowed) release(inStyle);
+            return true;
+        }
+        param.releaseStyle();
+        param.mStyle = inStyle;
+        param.mBorrowed = borrowed;
         return true;
     }
 
-    switch (param->getType() & FLAGMASK) {
-        case NUMBER:
-        case BOOL:
-        case BITS:
-            if (!std::holds_alternative<int32_t>(inParam)) return false;
-            break;
-        default:
-            Logger::error("setParam(): Invalid Parameter for index " + std::to_string(idx) + " in style " + osName);
-            return false;
-    }
+    const auto value{std::get<int32_t>(inParam)};
 
-    switch (param->getType() & FLAGMASK) {
+    switch (param.getType() & FLAGMASK) {
         case NUMBER:
-            static_cast<NumberParam*>(param)->setNum(std::get<int32_t>(inParam));
+            param.mValue = std::clamp<int32_t>(value, std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max() + 1);
             break;
         case BOOL:
-            static_cast<BoolParam*>(param)->setBool(std::get<int32_t>(inParam));
+            param.mValue = value != 0;
             break;
         case BITS:
-            static_cast<BitsParam*>(param)->setBits(std::get<int32_t>(inParam));
+            param.mValue = value & std::numeric_limits<uint16_t>::max();
             break;
         default:
             Logger::error("setParam(): Invalid Parameter for index " + std::to_string(idx) + " in style " + osName);
@@ -180,14 +206,15 @@ bool BladeStyle::setParam(size_t idx, const ParamValue& inParam) {
 }
 
 bool BladeStyle::addParam(const ParamValue& newParam) {
-    auto& lastParam{mParams.back()};
-    if (~lastParam->getType() & VARIADIC) return false;
+    const auto& lastParam{mParams.back()};
+    if (~lastParam.getType() & VARIADIC) return false;
 
-    switch (lastParam->getType() & FLAGMASK) {
+    switch (lastParam.getType() & FLAGMASK) {
         case NUMBER:
         case BITS:
         case BOOL:
             if (!std::holds_alternative<int32_t>(newParam)) return false;
+            mParams.push_back(Param(lastParam.name, lastParam.getType(), 0));
             break;
         case FUNCTION:
         case FUNCTION3D:
@@ -198,101 +225,89 @@ bool BladeStyle::addParam(const ParamValue& newParam) {
         case EFFECT:
         case LOCKUPTYPE:
         case ARGUMENT:
-            if (!std::holds_alternative<BladeStyle*>(newParam)) return false;
-            if (!(std::get<BladeStyle*>(newParam)->getType() & lastParam->getType() & FLAGMASK)) return false;
+            if (std::holds_alternative<int32_t>(newParam)) return false;
+            mParams.push_back(Param(lastParam.name, lastParam.getType(), nullptr));
             break;
         default:
             Logger::error("addParam(): Invalid type at end of params in style " + std::string(osName));
             return false;
     }
 
-    Param* param{nullptr};
-    switch (lastParam->getType() & FLAGMASK) {
-        case NUMBER:
-            param = new NumberParam(lastParam->name, std::get<int32_t>(newParam), lastParam->getType());
-            break;
-        case BITS:
-            param = new BitsParam(lastParam->name, std::get<int32_t>(newParam), lastParam->getType());
-            break;
-        case BOOL:
-            param = new BoolParam(lastParam->name, std::get<int32_t>(newParam), lastParam->getType());
-            break;
-        case FUNCTION:
-        case FUNCTION3D:
-        case COLOR:
-        case LAYER:
-        case TRANSITION:
-        case TIMEFUNC: 
-        case EFFECT:
-        case LOCKUPTYPE:
-        case ARGUMENT:
-            param = new StyleParam(lastParam->name, lastParam->getType(), std::get<BladeStyle*>(newParam));
-            break;
-        default:
-            Logger::error("addParam(): Invalid type at end of params in style " + std::string(osName));
-            return false;
+    if (!setParam(mParams.size() - 1, newParam)) {
+        mParams.pop_back();
+        return false;
     }
-
-    mParams.push_back(param);
     return true;
 }
 
 bool BladeStyle::removeParam(size_t idx) {
     if (idx >= mParams.size()) return false;
     auto iter{std::next(mParams.begin(), static_cast<int32_t>(idx))};
-    if (~(*iter)->getType() & VARIADIC) return false;
+    if (~iter->getType() & VARIADIC) return false;
 
-    if (*iter) delete (*iter);
+    iter->releaseStyle();
     mParams.erase(iter);
     return true;
 }
 
-const std::vector<Param*>& BladeStyle::getParams() const {
-    return mParams;
-}
+BladeStyle* BladeStyle::detachParamStyle(size_t idx) {
+    if (idx >= mParams.size()) return nullptr;
+    auto& param{mParams[idx]};
+    if (!(param.getType() & STYLETYPE)) return nullptr;
 
-const Param* BladeStyle::getParam(size_t idx) const {
-    return idx >= mParams.size() ? nullptr : *std::next(mParams.begin(), static_cast<int32_t>(idx));
+    auto *ret{param.mBorrowed ? nullptr : param.mStyle};
+    param.mStyle = nullptr;
+    param.mBorrowed = false;
+    return ret;
 }
 
-Param::Param(const char* name, const StyleType type) :
-    name(name), pType(type) {}
+BladeStyle* BladeStyle::getMutableParamStyle(size_t idx) {
+    if (idx >= mParams.size()) return nullptr;
+    auto& param{mParams[idx]};
+    if (!(param.getType() & STYLETYPE) || !param.mStyle || param.mBorrowed) return nullptr;
 
-StyleType Param::getType() const { return pType; }
+    if (param.mStyle->isShared()) {
+        auto *copy{param.mStyle->clone()};
+        if (!copy) return nullptr;
+        release(param.mStyle);
+        param.mStyle = copy;
+    }
+    return param.mStyle;
+}
 
-StyleParam::StyleParam(const char* name, StyleType type, BladeStyle* style) :
-    Param(name, type), mStyle(style) {}
+void BladeStyle::unshare() {
+    for (size_t idx{0}; idx < mParams.size(); idx++) {
+        auto *style{getMutableParamStyle(idx)};
+        if (style) style->unshare();
+    }
+}
 
-StyleParam::~StyleParam() {  delete mStyle; }
+const std::vector<Param>& BladeStyle::getParams() const {
+    return mParams;
+}
 
-void StyleParam::setStyle(BladeStyle* newStyle) {
-    delete mStyle;
-    mStyle = newStyle;
+const Param* BladeStyle::getParam(size_t idx) const {
+    return idx >= mParams.size() ? nullptr : &mParams[idx];
 }
 
-const BladeStyle* StyleParam::getStyle() const { return mStyle; }
+Param::Param(const char* name, const StyleType type, const int32_t value) :
+    name(name), mType(type), mValue(value) {}
 
-BladeStyle* StyleParam::detachStyle() {
-    auto *ret{mStyle};
-    mStyle = nullptr;
-    return ret;
+Param::Param(const char* name, const StyleType type, BladeStyle* style) :
+    name(name), mType(type), mStyle(style) {}
+
+void Param::releaseStyle() {
+    if ((mType & STYLETYPE) && !mBorrowed) BladeStyle::release(mStyle);
 }
 
-NumberParam::NumberParam(const char* name, const int32_t initialValue, const StyleType additionalFlags) :
-    Param(name, NUMBER | additionalFlags), mValue(initialValue) {}
+StyleParam::StyleParam(const char* name, StyleType type, BladeStyle* style) :
+    Param(name, type, style) {}
 
-void NumberParam::setNum(int32_t newValue) { mValue = std::clamp<int32_t>(newValue, std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max() + 1); }
-int32_t NumberParam::getNum() const { return mValue; }
+NumberParam::NumberParam(const char* name, const int32_t initialValue, const StyleType additionalFlags) :
+    Param(name, NUMBER | additionalFlags, initialValue) {}
 
 BitsParam::BitsParam(const char* name, const int32_t initialValue, const StyleType additionalFlags) :
-    Param(name, BITS | additionalFlags), mValue(initialValue & std::numeric_limits<uint16_t>::max()) {}
-
-void BitsParam::setBits(int32_t newValue) { mValue = newValue & std::numeric_limits<uint16_t>::max(); }
-int32_t BitsParam::getBits() const { return mValue; }
+    Param(name, BITS | additionalFlags, initialValue & std::numeric_limits<uint16_t>::max()) {}
 
 BoolParam::BoolParam(const char* name, const bool initialValue, const StyleType additionalFlags) :
-    Param(name, BOOL | additionalFlags), mValue(initialValue) {}
-
-void BoolParam::setBool(bool newValue) { mValue = newValue; }
-bool BoolParam::getBool() const { return mValue; }
-
+    Param(name, BOOL | additionalFlags, initialValue) {}
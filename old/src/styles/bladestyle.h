@@ -19,9 +19,12 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
@@ -89,48 +92,170 @@ inline constexpr int8_t getRefFromType(StyleType type) {
     return static_cast<int8_t>((type & REFMASK) >> REF_OFFSET);
 }
 
-class Param;
 class BladeStyle;
 
-using ParamValue = std::variant<int32_t, BladeStyle *>;
+/**
+ * A style given to a param without handing over a reference, for styles
+ * that wire up internal helper styles from their own params. The borrowed
+ * style must outlive the param.
+ */
+struct BorrowedStyle {
+    const BladeStyle* style;
+};
+inline BorrowedStyle borrow(const BladeStyle* style) { return { style }; }
+
+using ParamValue = std::variant<int32_t, BladeStyle *, BorrowedStyle>;
+
+/**
+ * A parameter as stored in its style: a name, a type, and either a value
+ * or a child style (which the owning style is responsible for).
+ *
+ * Params are small and trivially copyable so a style can keep them all
+ * inline in one block, rather than as separate heap objects.
+ */
+class Param {
+public:
+    [[nodiscard]] StyleType getType() const;
 
+    [[nodiscard]] const BladeStyle* getStyle() const;
+    [[nodiscard]] int32_t getNum() const;
+    [[nodiscard]] int32_t getBits() const;
+    [[nodiscard]] bool getBool() const;
+
+    const char* name;
+
+protected:
+    Param(const char* name, StyleType type, int32_t value);
+    Param(const char* name, StyleType type, BladeStyle* style);
+
+private:
+    friend class BladeStyle;
+
+    /**
+     * Drop the reference to the style, if there is one and it's not
+     * borrowed.
+     */
+    void releaseStyle();
+
+    StyleType mType;
+    bool mBorrowed{false};
+    union {
+        int32_t mValue;
+        BladeStyle* mStyle;
+    };
+};
+
+// Typed constructors for style definitions, these add no data and are
+// stored as plain Params.
+
+class StyleParam : public Param {
+public:
+    StyleParam(const char* name, StyleType type, BladeStyle* style);
+};
+
+class NumberParam : public Param {
+public:
+    NumberParam(const char* name, int32_t initialValue = 0, StyleType additionalFlags = 0);
+};
+
+class BitsParam : public Param {
+public:
+    BitsParam(const char* name, int32_t initialValue = 0, StyleType additionalFlags = 0);
+};
+
+class BoolParam : public Param {
+public:
+    BoolParam(const char* name, bool initialValue = false, StyleType additionalFlags = 0);
+};
+
+/**
+ * Styles are reference counted, and a child style may be shared by any
+ * number of parents (see clone()). A shared style must not be modified,
+ * use getMutableParamStyle() to get a child that's safe to edit.
+ */
 class BladeStyle {
 public:
-    BladeStyle(const BladeStyle&);
+    BladeStyle(const BladeStyle&) = delete;
     virtual ~BladeStyle();
 
+    /**
+     * Styles are allocated from the StylePool, since a preset is made of
+     * many small nodes that are created and destroyed together.
+     */
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size);
+
     [[nodiscard]] virtual StyleType getType() const;
 
+    /**
+     * Copy this style as its actual type.
+     *
+     * Child styles are shared with the original rather than copied, so
+     * this doesn't depend on the size of the tree.
+     *
+     * @return nullptr if osName isn't a known style
+     */
+    [[nodiscard]] BladeStyle* clone() const;
+
+    void retain() const;
+    /**
+     * Drop a reference, destroying style if it was the last.
+     */
+    static void release(const BladeStyle* style);
+    [[nodiscard]] bool isShared() const;
+
     bool setParams(const std::vector<ParamValue>&);
+    /**
+     * A BladeStyle* hands over the caller's reference, a BorrowedStyle
+     * doesn't. Either way the style the param held is released.
+     */
     bool setParam(size_t idx, const ParamValue&);
     bool addParam(const ParamValue&);
     /**
      * Used to remove variadic args
      */
     bool removeParam(size_t idx);
+    /**
+     * Clear the style param at idx and hand over its reference to the
+     * style, which may be shared. Returns nullptr for a borrowed style.
+     *
+     * Must acquire otherwise memory leak.
+     */
+    [[nodiscard]] BladeStyle* detachParamStyle(size_t idx);
+    /**
+     * Get the style param at idx for editing. If it's shared with another
+     * style, it's replaced with a copy first. Borrowed styles belong to
+     * someone else, so give nullptr.
+     */
+    [[nodiscard]] BladeStyle* getMutableParamStyle(size_t idx);
+    /**
+     * Make sure no style in this tree is shared, e.g. before rendering,
+     * since styles keep per-frame state.
+     */
+    void unshare();
 
-    [[nodiscard]] const std::vector<Param*>& getParams() const;
+    [[nodiscard]] const std::vector<Param>& getParams() const;
     [[nodiscard]] const Param* getParam(size_t idx) const;
     virtual bool validateParams(std::string* err = nullptr) const;
 
     /** 
-     * Get param as StyleParam, then get style from param.
-     * Use  with caution, it's just static casts! 
+     * Get style from param.
+     * Use  with caution, the param type isn't checked! 
      * */
     [[nodiscard]] inline const BladeStyle* getParamStyle(size_t idx) const;
     /** 
-     * Get param as NumberParam, then get number from param.
-     * Use  with caution, it's just static casts! 
+     * Get number from param.
+     * Use  with caution, the param type isn't checked! 
      * */
     [[nodiscard]] inline int32_t getParamNumber(size_t idx) const;
     /** 
-     * Get param as bitsparam, then get bits from param.
-     * Use  with caution, it's just static casts! 
+     * Get bits from param.
+     * Use  with caution, the param type isn't checked! 
      * */
     [[nodiscard]] inline int32_t getParamBits(size_t idx) const;
     /** 
-     * Get param as BoolParam, then get bool from param.
-     * Use  with caution, it's just static casts! 
+     * Get bool from param.
+     * Use  with caution, the param type isn't checked! 
      * */
     [[nodiscard]] inline bool getParamBool(size_t idx) const;
 
@@ -143,114 +268,65 @@ protected:
             const char* osName, 
             const char* humanName, 
             StyleType type,
-            const std::vector<Param*>& params
+            const std::vector<Param>& params
             );
 
     const StyleType pType;
 
 private:
-    std::vector<Param*> mParams;
-};
-
-class Param {
-public:
-    Param(const Param&) = delete;
-    virtual ~Param() = default;
-
-    [[nodiscard]] virtual StyleType getType() const;
-
-    const char* name;
-
-protected:
-    Param(const char* name, StyleType type);
-
-    const StyleType pType;
-};
-
-class StyleParam : public Param {
-public:
-    StyleParam(const StyleParam&) = delete;
-    StyleParam(const char* name, StyleType type, BladeStyle* style);
-     ~StyleParam() override;
-
-    void setStyle(BladeStyle*);
-    [[nodiscard]] const BladeStyle* getStyle() const;
-    /**
-     * Clear pointer, return style
-     *
-     * Must acquire otherwise memory leak.
-     */
-    [[nodiscard]] BladeStyle* detachStyle();
-
-private:
-    BladeStyle* mStyle;
+    std::vector<Param> mParams;
+    mutable std::atomic<uint32_t> mRefs{1};
 };
 
-class NumberParam : public Param {
-public:
-    NumberParam(const char* name, int32_t initialValue = 0, StyleType additionalFlags = 0);
-
-    void setNum(int32_t);
-    [[nodiscard]] int32_t getNum() const;
-
-private:
-    int32_t mValue;
-};
-
-class BitsParam : public Param {
-public:
-    BitsParam(const char* name, int32_t initialValue = 0, StyleType additionalFlags = 0);
-
-    void setBits(int32_t);
-    [[nodiscard]] int32_t getBits() const;
-
-private:
-    int32_t mValue;
-};
-
-class BoolParam : public Param {
-public:
-    BoolParam(const char* name, bool initialValue = false, StyleType additionalFlags = 0);
-
-    // These really don't need to exist for this one...
-    void setBool(bool);
-    [[nodiscard]] bool getBool() const;
-
-private:
-    bool mValue;
-};
+inline StyleType Param::getType() const { return mType; }
+inline const BladeStyle* Param::getStyle() const { return mStyle; }
+inline int32_t Param::getNum() const { return mValue; }
+inline int32_t Param::getBits() const { return mValue; }
+inline bool Param::getBool() const { return mValue; }
 
 inline const BladeStyle* BladeStyle::getParamStyle(size_t idx) const {
-    return static_cast<const StyleParam*>(getParam(idx))->getStyle();
+    return mParams[idx].getStyle();
 }
 
 inline int32_t BladeStyle::getParamNumber(size_t idx) const {
-    return static_cast<const NumberParam*>(getParam(idx))->getNum();
+    return mParams[idx].getNum();
 }
 
 inline int32_t BladeStyle::getParamBits(size_t idx) const {
-    return static_cast<const BitsParam*>(getParam(idx))->getBits();
+    return mParams[idx].getBits();
 }
 
 inline bool BladeStyle::getParamBool(size_t idx) const {
-    return static_cast<const BoolParam*>(getParam(idx))->getBool();
+    return mParams[idx].getBool();
 }
 
 using StyleGenerator = BladeStyle *(*)(const std::vector<ParamValue> &);
 using StyleMap = std::map<std::string, StyleGenerator>;
 
-StyleGenerator get(const std::string& styleName);
+struct StyleInfo {
+    StyleGenerator generator;
+    // What the style is registered as, e.g. FUNCTION or TRANSITION
+    StyleType type;
+};
+
+/**
+ * Look up a style of any kind by its osName, in one probe.
+ *
+ * @return nullptr if there's no such style
+ */
+[[nodiscard]] const StyleInfo* findStyle(std::string_view styleName);
+StyleGenerator get(std::string_view styleName);
 
 #define STYLECAST(resultType, input) const_cast<resultType*>(static_cast<const resultType*>(input)) // NOLINT(bugprone-macro-parentheses)
 
-#define PARAMS(...) (std::vector<Param*>{ __VA_ARGS__ })
+#define PARAMS(...) (std::vector<Param>{ __VA_ARGS__ })
 #define PARAMVEC(...) std::vector<ParamValue>{ __VA_ARGS__ }
 #define STYLEPAIR(name) { \
     #name, \
     [](const std::vector<ParamValue>& paramArgs) -> BladeStyle* { \
         auto ret{new name()}; \
         if (!ret->setParams(paramArgs)) { \
-            delete ret; \
+            BladeStyle::release(ret); \
             return nullptr; \
         } \
         return ret; \
@@ -0,0 +1,326 @@
+#include "bytecode.h"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * styles/bytecode.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <limits>
+#include <string_view>
+
+#include "stylepreview/profiler.h"
+#include "styles/elements/colorstyles.h"
+#include "styles/elements/functions.h"
+#include "styles/variance.h"
+
+using namespace BladeStyles;
+using namespace BladeStyles::Bytecode;
+
+namespace {
+
+class Compiler {
+public:
+    Compiler(
+            std::vector<Instruction>& instructions,
+            std::vector<ColorData>& colorPool,
+            std::vector<BladeStyle*>& nodes,
+            std::vector<std::vector<const BladeStyle*>>& nodePaths,
+            std::vector<Program::Binding>& bindings,
+            const VarianceMap& variance) :
+        mInstructions(instructions), mColorPool(colorPool), mNodes(nodes), mNodePaths(nodePaths), mBindings(bindings), mVariance(variance) {}
+
+    /**
+     * Emit the instructions computing style into register out, children
+     * first.
+     */
+    bool lower(BladeStyle* style, uint8_t out);
+
+    uint8_t numScalars{0};
+    uint8_t numIntRegisters{1};
+    std::string error;
+
+private:
+    bool lowerFunction(BladeStyle* style, uint8_t out);
+    bool lowerScalar(BladeStyle* style, uint8_t out);
+    /**
+     * Emit the instructions for every function below style which style
+     * would otherwise run itself, and bind each to its result.
+     */
+    bool lowerParams(BladeStyle* style);
+    void emitCall(OpCode op, BladeStyle* style, uint8_t out);
+
+    [[nodiscard]] bool allocScalar(uint8_t& reg);
+    [[nodiscard]] bool allocInts(uint8_t& reg);
+
+    std::vector<Instruction>& mInstructions;
+    std::vector<ColorData>& mColorPool;
+    std::vector<BladeStyle*>& mNodes;
+    std::vector<std::vector<const BladeStyle*>>& mNodePaths;
+    std::vector<Program::Binding>& mBindings;
+    const VarianceMap& mVariance;
+
+    // The styles above whatever's being lowered
+    std::vector<const BladeStyle*> mPath;
+};
+
+} // namespace
+
+Program* Program::compile(BladeStyle* style, std::string* err) {
+    if (!style || !(style->getType() & (WRAPPER | COLOR | LAYER | FUNCTION))) {
+        if (err) *err = "Only color, layer, wrapper, and function styles can be compiled";
+        return nullptr;
+    }
+
+    auto* program{new Program};
+    program->mOutputType = style->getType() & FUNCTION ? FUNCTION : COLOR;
+
+    const auto variance{analyzeVariance(style)};
+    Compiler compiler{program->mInstructions, program->mColorPool, program->mNodes, program->mNodePaths, program->mBindings, variance};
+    if (!compiler.lower(style, 0)) {
+        if (err) *err = compiler.error;
+        // Nothing's bound until the first frame
+        delete program;
+        return nullptr;
+    }
+
+    program->mScalars.resize(compiler.numScalars);
+    program->mNumIntRegisters = compiler.numIntRegisters;
+    return program;
+}
+
+Program::~Program() {
+    for (const auto& binding : mBindings) static_cast<FunctionStyle*>(binding.function)->bindValues({});
+}
+
+void Program::render(StylePreview::Blade& blade, LedFrame& out) {
+    if (mOutputType != COLOR) return;
+    execute(blade, out.size(), {}, &out);
+}
+
+void Program::evaluate(StylePreview::Blade& blade, std::span<int32_t> out) {
+    if (mOutputType != FUNCTION) return;
+    execute(blade, static_cast<int32_t>(out.size()), out, nullptr);
+}
+
+void Program::execute(StylePreview::Blade& blade, int32_t numLeds, std::span<int32_t> intOut, LedFrame* colorOut) {
+    if (numLeds != mNumLeds) {
+        mNumLeds = numLeds;
+        mIntRegisters.resize(static_cast<size_t>(mNumIntRegisters - 1) * numLeds);
+        if (numLeds > 0) bindFunctions();
+    }
+    if (numLeds <= 0) return;
+
+    const auto ints{[&](uint8_t reg) -> std::span<int32_t> {
+        if (reg == 0) return intOut;
+        return { mIntRegisters.data() + (static_cast<size_t>(reg - 1) * numLeds), static_cast<size_t>(numLeds) };
+    }};
+
+    for (const auto& instruction : mInstructions) {
+        switch (instruction.op) {
+            case OpCode::INT:
+                mScalars[instruction.out] = instruction.imm;
+                break;
+            case OpCode::BATTERY_LEVEL:
+                mScalars[instruction.out] = blade.batteryLevel;
+                break;
+            case OpCode::SAMPLE_FUNCTION: {
+                const StylePreview::Profiler::Scope profileScope{mNodePaths[instruction.imm], "run"};
+                auto* function{static_cast<FunctionStyle*>(mNodes[instruction.imm])};
+                // It's bound to the value it's about to work out
+                const auto bound{function->getBoundValues()};
+                function->bindValues({});
+                function->run(blade);
+                mScalars[instruction.out] = function->getInt(0);
+                function->bindValues(bound);
+                break;
+            }
+            case OpCode::SPLAT:
+                std::ranges::fill(ints(instruction.out), mScalars[instruction.in[0]]);
+                break;
+            case OpCode::BUMP: {
+                const BumpShape shape{mScalars[instruction.in[0]], mScalars[instruction.in[1]], numLeds};
+                shape.getInts(ints(instruction.out), 0);
+                break;
+            }
+            case OpCode::CALL_FUNCTION: {
+                const StylePreview::Profiler::Scope profileScope{mNodePaths[instruction.imm], "run"};
+                auto* function{static_cast<FunctionStyle*>(mNodes[instruction.imm])};
+                const auto bound{function->getBoundValues()};
+                function->bindValues({});
+                function->run(blade);
+                function->getInts(ints(instruction.out));
+                function->bindValues(bound);
+                break;
+            }
+            case OpCode::FIXED_COLOR:
+                colorOut->fill(mColorPool[instruction.imm]);
+                break;
+            case OpCode::CALL_COLOR: {
+                const StylePreview::Profiler::Scope profileScope{mNodePaths[instruction.imm], "run"};
+                auto* color{static_cast<ColorStyle*>(mNodes[instruction.imm])};
+                color->run(blade);
+                color->render(*colorOut);
+                break;
+            }
+        }
+    }
+}
+
+void Program::bindFunctions() {
+    for (const auto& binding : mBindings) {
+        auto* function{static_cast<FunctionStyle*>(binding.function)};
+        if (binding.perLed) {
+            function->bindValues({ mIntRegisters.data() + (static_cast<size_t>(binding.reg - 1) * mNumLeds), static_cast<size_t>(mNumLeds) });
+        } else {
+            function->bindValues({ &mScalars[binding.reg], 1 });
+        }
+    }
+}
+
+bool Compiler::lower(BladeStyle* style, uint8_t out) {
+    const auto type{style->getType()};
+
+    // Wrappers only forward to their contents
+    if (type & WRAPPER) {
+        mPath.push_back(style);
+        if (!lower(const_cast<BladeStyle*>(style->getParamStyle(0)), out)) return false;
+        mPath.pop_back();
+        return true;
+    }
+    if (type & FUNCTION) return lowerFunction(style, out);
+
+    if (type & FIXEDCOLOR) {
+        mInstructions.push_back({
+            .op = OpCode::FIXED_COLOR,
+            .out = out,
+            .imm = static_cast<int32_t>(mColorPool.size()),
+        });
+        mColorPool.push_back(static_cast<ColorStyle*>(style)->getColor(0));
+        return true;
+    }
+
+    if (!lowerParams(style)) return false;
+    emitCall(OpCode::CALL_COLOR, style, out);
+    return true;
+}
+
+bool Compiler::lowerFunction(BladeStyle* style, uint8_t out) {
+    // Anything which is the same for the whole blade is worked out once
+    if (mVariance.at(style) != Variance::PER_LED) {
+        Instruction instruction{ .op = OpCode::SPLAT, .out = out };
+        if (!allocScalar(instruction.in[0])) return false;
+        if (!lowerScalar(style, instruction.in[0])) return false;
+        mInstructions.push_back(instruction);
+        return true;
+    }
+
+    if (std::string_view{style->osName} == "Bump") {
+        // Bump<> only samples its params at the first LED
+        Instruction instruction{ .op = OpCode::BUMP, .out = out };
+        mPath.push_back(style);
+        for (size_t idx{0}; idx < instruction.in.size(); idx++) {
+            if (!allocScalar(instruction.in[idx])) return false;
+            if (!lowerScalar(const_cast<BladeStyle*>(style->getParamStyle(idx)), instruction.in[idx])) return false;
+        }
+        mPath.pop_back();
+        mInstructions.push_back(instruction);
+        return true;
+    }
+
+    if (!lowerParams(style)) return false;
+    emitCall(OpCode::CALL_FUNCTION, style, out);
+    return true;
+}
+
+bool Compiler::lowerScalar(BladeStyle* style, uint8_t out) {
+    auto* function{static_cast<FunctionStyle*>(style)};
+
+    if (mVariance.at(style) == Variance::CONSTANT) {
+        // Constants don't depend on the blade, so any will do
+        StylePreview::Blade blade;
+        function->run(blade);
+        mInstructions.push_back({ .op = OpCode::INT, .out = out, .imm = function->getInt(0) });
+        return true;
+    }
+    if (std::string_view{style->osName} == "BatteryLevel") {
+        mInstructions.push_back({ .op = OpCode::BATTERY_LEVEL, .out = out });
+        return true;
+    }
+
+    if (!lowerParams(style)) return false;
+    emitCall(OpCode::SAMPLE_FUNCTION, style, out);
+    return true;
+}
+
+bool Compiler::lowerParams(BladeStyle* style) {
+    mPath.push_back(style);
+    for (const auto& param : style->getParams()) {
+        if (!(param.getType() & STYLETYPE)) continue;
+        auto* paramStyle{const_cast<BladeStyle*>(param.getStyle())};
+        if (!paramStyle) continue;
+
+        // Whatever isn't a function still runs its own params, so find
+        // the functions under it.
+        if (!(paramStyle->getType() & FUNCTION)) {
+            if (!lowerParams(paramStyle)) return false;
+            continue;
+        }
+
+        Program::Binding binding{ .function = paramStyle };
+        if (mVariance.at(paramStyle) == Variance::PER_LED) {
+            binding.perLed = true;
+            if (!allocInts(binding.reg)) return false;
+            if (!lowerFunction(paramStyle, binding.reg)) return false;
+        } else {
+            if (!allocScalar(binding.reg)) return false;
+            if (!lowerScalar(paramStyle, binding.reg)) return false;
+        }
+        mBindings.push_back(binding);
+    }
+    mPath.pop_back();
+    return true;
+}
+
+void Compiler::emitCall(OpCode op, BladeStyle* style, uint8_t out) {
+    mInstructions.push_back({
+        .op = op,
+        .out = out,
+        .imm = static_cast<int32_t>(mNodes.size()),
+    });
+    mNodes.push_back(style);
+    mNodePaths.push_back(mPath);
+}
+
+bool Compiler::allocScalar(uint8_t& reg) {
+    if (numScalars == std::numeric_limits<uint8_t>::max()) {
+        error = "Style uses too many values to compile";
+        return false;
+    }
+    reg = numScalars++;
+    return true;
+}
+
+bool Compiler::allocInts(uint8_t& reg) {
+    if (numIntRegisters == std::numeric_limits<uint8_t>::max()) {
+        error = "Style uses too many values to compile";
+        return false;
+    }
+    reg = numIntRegisters++;
+    return true;
+}
+
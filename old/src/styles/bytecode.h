@@ -0,0 +1,152 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * styles/bytecode.h
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "stylepreview/blade.h"
+#include "styles/bladestyle.h"
+#include "styles/colordata.h"
+#include "styles/ledframe.h"
+
+/*
+ * A BladeStyle tree lowered to a flat list of instructions.
+ *
+ * Every instruction works on the whole blade at once, writing to a
+ * register holding either a value per LED (ints) or a single value for the
+ * frame (scalars). Instructions are in dependency order, so the
+ * interpreter is just one pass down the list.
+ *
+ * Only functions are lowered. Colors and layers are not: the outermost
+ * one is called through its usual run()/render() straight into the output
+ * frame, and renders everything under it itself. Function elements with a
+ * native op are evaluated directly, and the rest are called through
+ * run()/getInts(), so every valid style can be compiled. Every function below a called element is evaluated
+ * ahead of it and bound to the result (see FunctionStyle::bindValues()),
+ * so the element only reads its function params back.
+ *
+ * Using analyzeVariance(), CONSTANT functions are evaluated once at
+ * compile time and become immediates, and PER_FRAME functions are only
+ * evaluated once per frame, into a scalar. This applies to functions
+ * anywhere in the tree, e.g. a BlinkingF<> param under a color.
+ */
+namespace BladeStyles::Bytecode {
+
+enum class OpCode : uint8_t {
+    // scalars[out] = imm
+    INT,
+    // scalars[out] = blade battery level
+    BATTERY_LEVEL,
+    // scalars[out] = nodes[imm] at LED 0
+    SAMPLE_FUNCTION,
+
+    // ints[out] = scalars[in[0]]
+    SPLAT,
+    // ints[out] = Bump<scalars[in[0]], scalars[in[1]]>
+    BUMP,
+    // ints[out] = nodes[imm]
+    CALL_FUNCTION,
+
+    // output frame = colorPool[imm]
+    FIXED_COLOR,
+    // output frame = nodes[imm]
+    CALL_COLOR,
+};
+
+struct Instruction {
+    OpCode op;
+    // Int register 0 is the program output.
+    uint8_t out{0};
+    std::array<uint8_t, 2> in{};
+    // Immediate value, or index into the color pool/node table.
+    int32_t imm{0};
+};
+
+class Program {
+public:
+    /**
+     * Lower a validated style. The tree is not owned and must outlive the
+     * program, and must not share any nodes (see BladeStyle::unshare()).
+     * Functions in it stay bound to the program until it's destroyed.
+     *
+     * @return nullptr if style is not a color/layer/wrapper/function
+     * style or is too large to compile, otherwise caller must take
+     * ownership.
+     */
+    [[nodiscard]] static Program* compile(BladeStyle* style, std::string* err = nullptr);
+
+    /**
+     * COLOR or FUNCTION, depending on what the program renders.
+     */
+    [[nodiscard]] StyleType getOutputType() const { return mOutputType; }
+    [[nodiscard]] std::span<const Instruction> getInstructions() const { return mInstructions; }
+
+    /**
+     * Run a COLOR program for one frame, rendering into out.
+     */
+    void render(StylePreview::Blade&, LedFrame& out);
+    /**
+     * Run a FUNCTION program for one frame, writing the value for each LED
+     * into out.
+     */
+    void evaluate(StylePreview::Blade&, std::span<int32_t> out);
+
+    Program(const Program&) = delete;
+    Program& operator=(const Program&) = delete;
+    ~Program();
+
+    /**
+     * A function in the tree and the register it's evaluated into.
+     */
+    struct Binding {
+        BladeStyle* function{nullptr};
+        // Otherwise a scalar
+        bool perLed{false};
+        uint8_t reg{0};
+    };
+
+private:
+    Program() = default;
+
+    void execute(StylePreview::Blade&, int32_t numLeds, std::span<int32_t> intOut, LedFrame* colorOut);
+    void bindFunctions();
+
+    StyleType mOutputType{0};
+    std::vector<Instruction> mInstructions;
+    std::vector<ColorData> mColorPool;
+    std::vector<BladeStyle*> mNodes;
+    // The styles above each node, outermost first, so it's profiled under
+    // the same path as when its parent calls it.
+    std::vector<std::vector<const BladeStyle*>> mNodePaths;
+    std::vector<Binding> mBindings;
+
+    uint8_t mNumIntRegisters{0};
+    int32_t mNumLeds{0};
+    std::vector<int32_t> mScalars;
+    // Register 0 is never stored here, it's always the output.
+    std::vector<int32_t> mIntRegisters;
+};
+
+} // namespace BladeStyles::Bytecode
+
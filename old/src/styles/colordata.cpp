@@ -27,14 +27,15 @@ ColorData BladeStyles::mixColors(const ColorData& colorA, const ColorData& color
 }
 
 bool ColorData::operator==(const ColorData& other) const {
-    return (red == other.red) && (green == other.green) && (blue == other.blue);
+    return (red == other.red) && (green == other.green) && (blue == other.blue) && (alpha == other.alpha);
 }
 
 ColorData ColorData::operator*(uint16_t multiplier) const {
     return ColorData{
         .red = red * multiplier,
         .green = green * multiplier,
-        .blue = blue * multiplier
+        .blue = blue * multiplier,
+        .alpha = alpha * multiplier,
     };
 }
 
@@ -42,7 +43,8 @@ ColorData ColorData::operator+(const ColorData& other) const {
     return ColorData{
         .red = red + other.red,
         .green = green + other.green,
-        .blue = blue + other.blue
+        .blue = blue + other.blue,
+        .alpha = alpha + other.alpha,
     };
 }
 
@@ -51,6 +53,7 @@ ColorData ColorData::operator>>(int32_t shift) const {
         .red = red >> shift,
         .green = green >> shift,
         .blue = blue >> shift,
+        .alpha = alpha >> shift,
     };
 }
 
@@ -21,6 +21,7 @@
  */
 
 #include <cstdint>
+#include <limits>
 
 #include <wx/colour.h>
 
@@ -0,0 +1,131 @@
+#include "colorkernels.h"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * styles/colorkernels.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(__AVX2__)
+#   include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#   include <emmintrin.h>
+#   define KERNELS_SSE2
+#endif
+
+using namespace BladeStyles;
+
+static constexpr uint32_t ALPHA_MAX{32768};
+static constexpr int32_t ALPHA_SHIFT{15};
+
+#if defined(__AVX2__)
+
+static constexpr size_t LANES{8};
+using Vec = __m256i;
+
+static inline Vec load(const uint32_t* ptr) { return _mm256_loadu_si256(reinterpret_cast<const Vec*>(ptr)); }
+static inline void store(uint32_t* ptr, Vec vec) { _mm256_storeu_si256(reinterpret_cast<Vec*>(ptr), vec); }
+static inline Vec splat(uint32_t val) { return _mm256_set1_epi32(static_cast<int32_t>(val)); }
+static inline Vec add(Vec lhs, Vec rhs) { return _mm256_add_epi32(lhs, rhs); }
+static inline Vec sub(Vec lhs, Vec rhs) { return _mm256_sub_epi32(lhs, rhs); }
+static inline Vec mul(Vec lhs, Vec rhs) { return _mm256_mullo_epi32(lhs, rhs); }
+static inline Vec shiftRight(Vec vec, int32_t shift) { return _mm256_srl_epi32(vec, _mm_cvtsi32_si128(shift)); }
+
+#elif defined(KERNELS_SSE2)
+
+static constexpr size_t LANES{4};
+using Vec = __m128i;
+
+static inline Vec load(const uint32_t* ptr) { return _mm_loadu_si128(reinterpret_cast<const Vec*>(ptr)); }
+static inline void store(uint32_t* ptr, Vec vec) { _mm_storeu_si128(reinterpret_cast<Vec*>(ptr), vec); }
+static inline Vec splat(uint32_t val) { return _mm_set1_epi32(static_cast<int32_t>(val)); }
+static inline Vec add(Vec lhs, Vec rhs) { return _mm_add_epi32(lhs, rhs); }
+static inline Vec sub(Vec lhs, Vec rhs) { return _mm_sub_epi32(lhs, rhs); }
+static inline Vec mul(Vec lhs, Vec rhs) {
+    // SSE2 has no 32-bit mullo, so multiply even and odd lanes separately and interleave
+    const auto even{_mm_mul_epu32(lhs, rhs)};
+    const auto odd{_mm_mul_epu32(_mm_srli_si128(lhs, 4), _mm_srli_si128(rhs, 4))};
+    return _mm_unpacklo_epi32(
+            _mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0))
+            );
+}
+static inline Vec shiftRight(Vec vec, int32_t shift) { return _mm_srl_epi32(vec, _mm_cvtsi32_si128(shift)); }
+
+#else
+
+static constexpr size_t LANES{0};
+
+#endif
+
+void Kernels::mix(std::span<const uint32_t> planeA, std::span<const uint32_t> planeB, std::span<const uint32_t> weights, std::span<uint32_t> out, int32_t shift) {
+    const uint32_t max{1U << shift};
+    size_t idx{0};
+#   if defined(__AVX2__) || defined(KERNELS_SSE2)
+    const auto maxVec{splat(max)};
+    for (; idx + LANES <= out.size(); idx += LANES) {
+        const auto weight{load(weights.data() + idx)};
+        const auto mixed{add(mul(load(planeA.data() + idx), sub(maxVec, weight)), mul(load(planeB.data() + idx), weight))};
+        store(out.data() + idx, shiftRight(mixed, shift));
+    }
+#   endif
+    for (; idx < out.size(); idx++) {
+        out[idx] = ((planeA[idx] * (max - weights[idx])) + (planeB[idx] * weights[idx])) >> shift;
+    }
+}
+
+void Kernels::mix(std::span<const uint32_t> planeA, std::span<const uint32_t> planeB, uint32_t weight, std::span<uint32_t> out, int32_t shift) {
+    const uint32_t max{1U << shift};
+    size_t idx{0};
+#   if defined(__AVX2__) || defined(KERNELS_SSE2)
+    const auto weightVec{splat(weight)};
+    const auto invWeightVec{splat(max - weight)};
+    for (; idx + LANES <= out.size(); idx += LANES) {
+        const auto mixed{add(mul(load(planeA.data() + idx), invWeightVec), mul(load(planeB.data() + idx), weightVec))};
+        store(out.data() + idx, shiftRight(mixed, shift));
+    }
+#   endif
+    for (; idx < out.size(); idx++) {
+        out[idx] = ((planeA[idx] * (max - weight)) + (planeB[idx] * weight)) >> shift;
+    }
+}
+
+void Kernels::compositeAlpha(std::span<const uint32_t> baseAlpha, std::span<const uint32_t> layerAlpha, std::span<uint32_t> out) {
+    size_t idx{0};
+#   if defined(__AVX2__) || defined(KERNELS_SSE2)
+    const auto maxVec{splat(ALPHA_MAX)};
+    for (; idx + LANES <= out.size(); idx += LANES) {
+        const auto base{load(baseAlpha.data() + idx)};
+        store(out.data() + idx, add(base, shiftRight(mul(sub(maxVec, base), load(layerAlpha.data() + idx)), ALPHA_SHIFT)));
+    }
+#   endif
+    for (; idx < out.size(); idx++) {
+        out[idx] = baseAlpha[idx] + (((ALPHA_MAX - baseAlpha[idx]) * layerAlpha[idx]) >> ALPHA_SHIFT);
+    }
+}
+
+void Kernels::scale(std::span<const uint32_t> plane, std::span<const uint32_t> multipliers, std::span<uint32_t> out, int32_t shift) {
+    size_t idx{0};
+#   if defined(__AVX2__) || defined(KERNELS_SSE2)
+    for (; idx + LANES <= out.size(); idx += LANES) {
+        store(out.data() + idx, shiftRight(mul(load(plane.data() + idx), load(multipliers.data() + idx)), shift));
+    }
+#   endif
+    for (; idx < out.size(); idx++) {
+        out[idx] = (plane[idx] * multipliers[idx]) >> shift;
+    }
+}
+
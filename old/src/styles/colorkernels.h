@@ -0,0 +1,60 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * styles/colorkernels.h
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <span>
+
+/*
+ * Whole-blade versions of the ColorData operations, working on one color
+ * plane (i.e. all the reds) at a time so they can be vectorized.
+ *
+ * Uses AVX2 or SSE2 when the build targets them, otherwise plain loops.
+ * All spans passed to a call must be the same size, and out may alias any
+ * of the inputs.
+ *
+ * Channel values are on the usual 0-32768 scale, and weights/alphas are
+ * 0-(1 << shift). (This keeps every intermediate within 32 bits, same as
+ * mixColors())
+ */
+namespace BladeStyles::Kernels {
+
+/**
+ * out[i] = (planeA[i] * ((1 << shift) - weights[i]) + planeB[i] * weights[i]) >> shift
+ */
+void mix(std::span<const uint32_t> planeA, std::span<const uint32_t> planeB, std::span<const uint32_t> weights, std::span<uint32_t> out, int32_t shift);
+/**
+ * Same as above, with one weight for every LED
+ */
+void mix(std::span<const uint32_t> planeA, std::span<const uint32_t> planeB, uint32_t weight, std::span<uint32_t> out, int32_t shift);
+
+/**
+ * Alpha of layer painted over base:
+ * out[i] = baseAlpha[i] + ((32768 - baseAlpha[i]) * layerAlpha[i] >> 15)
+ */
+void compositeAlpha(std::span<const uint32_t> baseAlpha, std::span<const uint32_t> layerAlpha, std::span<uint32_t> out);
+
+/**
+ * out[i] = (plane[i] * multipliers[i]) >> shift
+ */
+void scale(std::span<const uint32_t> plane, std::span<const uint32_t> multipliers, std::span<uint32_t> out, int32_t shift);
+
+} // namespace BladeStyles::Kernels
+
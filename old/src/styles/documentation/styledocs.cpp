@@ -94,6 +94,11 @@ void generateDocs() {
         return type;
     }};
 
+    static const auto findValue{[](const PConf::Entry& section, PConf::Key key) -> std::string {
+        const auto *entry{section.find(key)};
+        return std::string{entry ? entry->value.value_or("") : ""};
+    }};
+
     std::ifstream docFile; 
     for (const auto& file : DOC_FILES) {
         docFile.open(wxGetCwd().ToStdString() + RESOURCEPATH "styledocs/" + file);
@@ -103,66 +108,50 @@ void generateDocs() {
         }
         Logger::info(std::string("Reading StyleDoc: ") + file);
 
-        while (docFile.peek() != EOF) {
-            auto *sect{PConf::readSection(docFile)};
-            if (!sect) {
+        auto doc{PConf::Document::read(docFile)};
+        docFile.close();
+        for (const auto& sect : doc.entries()) {
+            if (sect.getType() != PConf::DataType::SECTION) {
                 Logger::info("Stray entry in StyleDoc file.");
                 continue;
             }
-            if (sect->name != "ELEMENT") {
+            if (sect.key != PConf::Key::ELEMENT) {
                 Logger::info("Stray non-element section in StyleDoc file.");
                 continue;
             }
-            if (!sect->label) {
+            if (!sect.label) {
                 Logger::warn("Element missing label in StyleDoc file");
                 continue;
             }
 
             DocInfo info{
-                .humanName = sect->label.value(),
-                .osName{},
-                .description{},
+                .humanName = std::string(sect.label.value()),
+                .osName = findValue(sect, PConf::Key::OSNAME),
+                .type = parseType(findValue(sect, PConf::Key::TYPE)),
+                .description = findValue(sect, PConf::Key::DESCRIPTION),
                 .args{},
             };
-            for (auto *entry : sect->entries) {
-                if (!entry->value) {
-                    Logger::warn("Stray entry without value in element: " + info.humanName);
+
+            const auto *arguments{sect.find(PConf::Key::ARGUMENTS)};
+            if (arguments && arguments->getType() != PConf::DataType::SECTION) {
+                Logger::warn("Argument section read as entry in element: " + info.humanName);
+                arguments = nullptr;
+            }
+            for (const auto& arg : arguments ? arguments->entries : std::span<const PConf::Entry>{}) {
+                if (!arg.label) {
+                    Logger::warn("Argument with missing name in element: " + info.humanName);
                     continue;
                 }
-
-                if (entry->name == "TYPE") info.type = parseType(entry->value.value());
-                else if (entry->name == "OSNAME") info.osName = entry->value.value();
-                else if (entry->name == "DESCRIPTION") info.description = entry->value.value();
-                else if (entry->name == "ARGUMENTS") {
-                    if (entry->getType() != PConf::DataType::SECTION) {
-                        Logger::warn("Argument section read as entry in element: " + info.humanName);
-                        continue;
-                    }
-
-                    for (auto *const arg : static_cast<PConf::Section*>(entry)->entries) {
-                        if (!arg->label) {
-                            Logger::warn("Argument with missing name in element: " + info.humanName);
-                            continue;
-                        }
-                        if (arg->getType() != PConf::DataType::SECTION) {
-                            Logger::warn("Argument \"" + arg->label.value() + "\" section interpreted as entry in element: " + info.humanName);
-                            continue;
-                        }
-
-                        DocInfo::ArgInfo argInfo{
-                            .name = arg->label.value(),
-                            .description{},
-                        };
-                        for (auto *const argEntry : static_cast<PConf::Section*>(arg)->entries) {
-                            if (!arg->value) {
-                                Logger::warn("Missing value for entry \"" + argEntry->name + "\" in argument \"" + arg->name + "\" for element: " + info.humanName);
-                                continue;
-                            }
-                            if (arg->name == "TYPE") argInfo.type = parseType(arg->value.value());
-                            else if (arg->name == "DESC") argInfo.description = arg->value.value();
-                        }
-                    }
+                if (arg.getType() != PConf::DataType::SECTION) {
+                    Logger::warn("Argument \"" + std::string(arg.label.value()) + "\" section interpreted as entry in element: " + info.humanName);
+                    continue;
                 }
+
+                info.args.push_back({
+                    .name = std::string(arg.label.value()),
+                    .type = parseType(findValue(arg, PConf::Key::TYPE)),
+                    .description = findValue(arg, PConf::Key::DESC),
+                });
             }
 
             docMap->emplace(info.osName, info);
@@ -20,6 +20,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 using namespace BladeStyles;
 
 // Yes, I know primary colors are something else...
@@ -143,6 +145,10 @@ void FixedColorStyle::run(StylePreview::Blade&) {}
 
 ColorData FixedColorStyle::getColor(int32_t) { return mColor; }
 
+void FixedColorStyle::getColors(std::span<ColorData> out, int32_t) { std::fill(out.begin(), out.end(), mColor); }
+
+void FixedColorStyle::render(LedFrame& out) { out.fill(mColor); }
+
 StyleGenerator FixedColorStyle::get(const std::string& styleName) {
     const auto& mapIt{map.find(styleName)};
     if (mapIt == map.end()) return nullptr;
@@ -153,7 +159,8 @@ const StyleMap& FixedColorStyle::getMap() { return map; }
 
 const StyleMap FixedColorStyle::map {
 // For now the humanName is just the osName
-#define VAL(red, green, blue) ColorData{red, green, blue}
+// Colors are listed 0-255, but ColorData is on a 0-32768 scale
+#define VAL(red, green, blue) ColorData{(red) * 32768U / 255, (green) * 32768U / 255, (blue) * 32768U / 255}
 #define CMAP(name, value) \
     { \
         name, \
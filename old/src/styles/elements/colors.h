@@ -34,6 +34,8 @@ public:
 
     void run(StylePreview::Blade&) override;
     ColorData getColor(int32_t led) override;
+    void getColors(std::span<ColorData> out, int32_t ledBegin) override;
+    void render(LedFrame& out) override;
 
     static StyleGenerator get(const std::string& styleName);
     static const StyleMap& getMap();
@@ -1,6 +1,9 @@
 #include "colorstyles.h"
 #include "styles/bladestyle.h"
 #include "styles/elements/colors.h"
+#include "stylepreview/profiler.h"
+#include <algorithm>
+#include <array>
 #include <cmath>
 /*
  * ProffieConfig, All-In-One Proffieboard Management Utility
@@ -33,9 +36,24 @@ StyleGenerator ColorStyle::get(const std::string& name) {
     return mapIt->second;
 }
 
-ColorStyle::ColorStyle(const char* osName, const char* humanName, const std::vector<Param*>& params, StyleType typeOverride) :
+ColorStyle::ColorStyle(const char* osName, const char* humanName, const std::vector<Param>& params, StyleType typeOverride) :
     BladeStyle(osName, humanName, typeOverride ? typeOverride : COLOR, params) {}
 
+void ColorStyle::getColors(std::span<ColorData> out, int32_t ledBegin) {
+    for (auto& color : out) color = getColor(ledBegin++);
+}
+
+void ColorStyle::render(LedFrame& out) {
+    PROFILE_STYLE("render");
+    constexpr int32_t CHUNK_SIZE{32};
+    std::array<ColorData, CHUNK_SIZE> chunk;
+    for (int32_t ledBegin{0}; ledBegin < out.size(); ledBegin += CHUNK_SIZE) {
+        const auto colors{std::span{chunk}.first(static_cast<size_t>(std::min(CHUNK_SIZE, out.size() - ledBegin)))};
+        getColors(colors, ledBegin);
+        out.setColors(colors, ledBegin);
+    }
+}
+
 #define CSTYLE(osName, humanName, params, ...) \
     class osName : public ColorStyle { \
     public: \
@@ -43,9 +61,12 @@ ColorStyle::ColorStyle(const char* osName, const char* humanName, const std::vec
         __VA_ARGS__ \
     }; 
 
+// The element's body goes in the *Impl function, so every call can be profiled
 #define RUN(varname) \
-    virtual void run(StylePreview::Blade& (varname)) override
+    virtual void run(StylePreview::Blade& blade) override { PROFILE_STYLE("run"); runImpl(blade); } \
+    void runImpl(StylePreview::Blade& (varname))
 
+// Called per LED, so not profiled
 #define GETCOLOR(varname) \
     virtual ColorData getColor(const int32_t (varname)) override
 
@@ -91,8 +112,8 @@ ColorStyle::ColorStyle(const char* osName, const char* humanName, const std::vec
 
     CSTYLE(AudioFlicker, "Audio Flicker",
             PARAMS(
-                new StyleParam("Base Color", COLOR, nullptr),
-                new StyleParam("Flicker Color", COLOR | LAYER, nullptr),
+                StyleParam("Base Color", COLOR, nullptr),
+                StyleParam("Flicker Color", COLOR | LAYER, nullptr),
                 ),
             RUN(blade) {
 
@@ -372,14 +393,14 @@ ColorStyle::ColorStyle(const char* osName, const char* humanName, const std::vec
 // of values.
 CSTYLE(Cylon, "Cylon",
         PARAMS(
-            new StyleParam("Off Color", COLOR, nullptr),
-            new NumberParam("Off Size (%)"), 
-            new NumberParam("Off RPM"),
-            new StyleParam("On Color", COLOR | REFARG_1, nullptr),
-            new NumberParam("On Size (%)", 0, REFARG_2), 
-            new NumberParam("On RPM", 0, REFARG_3),
-            new NumberParam("Fade Time (ms)", 1),
-            new StyleParam("Base Color", COLOR, FixedColorStyle::get("BLACK")({}))
+            StyleParam("Off Color", COLOR, nullptr),
+            NumberParam("Off Size (%)"), 
+            NumberParam("Off RPM"),
+            StyleParam("On Color", COLOR | REFARG_1, nullptr),
+            NumberParam("On Size (%)", 0, REFARG_2), 
+            NumberParam("On RPM", 0, REFARG_3),
+            NumberParam("Fade Time (ms)", 1),
+            StyleParam("Base Color", COLOR, FixedColorStyle::get("BLACK")({}))
             ),
         RUN(blade) {
 
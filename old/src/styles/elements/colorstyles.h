@@ -21,10 +21,12 @@
  */
 
 #include <cstdint>
+#include <span>
 
 #include "styles/bladestyle.h"
 #include "stylepreview/blade.h"
 #include "styles/colordata.h"
+#include "styles/ledframe.h"
 
 namespace BladeStyles {
 
@@ -40,12 +42,25 @@ public:
      * Get color per led
      */
     virtual ColorData getColor(int32_t) = 0;
+    /**
+     * Fill out with the colors for LEDs [ledBegin, ledBegin + out.size())
+     *
+     * The default calls getColor() for each LED.
+     */
+    virtual void getColors(std::span<ColorData> out, int32_t ledBegin = 0);
+    /**
+     * Write the colors for the whole blade into out, in place.
+     * LAYER styles paint over what's already there instead.
+     *
+     * The default goes through getColors() in chunks.
+     */
+    virtual void render(LedFrame& out);
 
     static StyleGenerator get(const std::string& styleName);
     static const StyleMap& getMap();
 
 protected:
-    ColorStyle(const char* osName, const char* humanName, const std::vector<Param*>& params, StyleType typeOverride = 0);
+    ColorStyle(const char* osName, const char* humanName, const std::vector<Param>& params, StyleType typeOverride = 0);
 
 private:
     static const StyleMap map;
@@ -20,17 +20,19 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstdlib>
 #include <limits>
+#include <vector>
 
 #include "proffieconstructs/vector3d.h"
-#include "proffieconstructs/utilfuncs.h"
+#include "proffieconstructs/random.h"
 #include "stylepreview/blade.h"
+#include "stylepreview/profiler.h"
 #include "styles/bladestyle.h"
 #include "styles/elements/effects.h"
-#include "utility/time.h"
 
 using namespace BladeStyles;
 
@@ -59,10 +61,10 @@ static constexpr std::array<uint8_t, 33> BUMP_SHAPE{
  * while non-X functions (if there's an X variant) take raw ints, and wrap the X version.
  */
 
-FunctionStyle::FunctionStyle(const char* osName, const char* humanName, const std::vector<Param*>& params, StyleType typeOverride) :
+FunctionStyle::FunctionStyle(const char* osName, const char* humanName, const std::vector<Param>& params, StyleType typeOverride) :
     BladeStyle(osName, humanName, typeOverride ? typeOverride : BladeStyles::FUNCTION, params) {}
 
-Function3DStyle::Function3DStyle(const char* osName, const char* humanName, const std::vector<Param*>& params) :
+Function3DStyle::Function3DStyle(const char* osName, const char* humanName, const std::vector<Param>& params) :
     BladeStyle(osName, humanName, BladeStyles::FUNCTION3D, params) {}
 
 StyleGenerator BladeStyles::FunctionStyle::get(const std::string& styleName) {
@@ -81,9 +83,88 @@ StyleGenerator Function3DStyle::get(const std::string& styleName) {
 
 const StyleMap& Function3DStyle::getMap() { return map; }
 
-#define RUN(varname) virtual void run(StylePreview::Blade& varname) override
-#define GETINT(varname) virtual int32_t getInt(int32_t varname) override
+void FunctionStyle::getInts(std::span<int32_t> out, int32_t ledBegin) {
+    if (isBound()) {
+        getBoundInts(out, ledBegin);
+        return;
+    }
+    PROFILE_STYLE("getInts");
+    for (auto& value : out) value = getInt(ledBegin++);
+}
+
+int32_t FunctionStyle::getBoundInt(int32_t led) const {
+    const auto last{static_cast<int32_t>(mBoundValues.size()) - 1};
+    return mBoundValues[std::clamp(led, 0, last)];
+}
+
+void FunctionStyle::getBoundInts(std::span<int32_t> out, int32_t ledBegin) const {
+    const auto numBound{static_cast<int32_t>(mBoundValues.size())};
+    if (numBound == 1) {
+        std::ranges::fill(out, mBoundValues[0]);
+        return;
+    }
+    if (ledBegin < 0 || ledBegin + static_cast<int32_t>(out.size()) > numBound) {
+        for (auto& value : out) value = getBoundInt(ledBegin++);
+        return;
+    }
+    std::ranges::copy(mBoundValues.subspan(ledBegin, out.size()), out.begin());
+}
+
+Variance FunctionStyle::getVariance() const { return Variance::PER_LED; }
+
+BumpShape::BumpShape(int32_t position, int32_t width, int32_t numLeds) {
+    if (width == 0) return;
+
+    constexpr auto MAX_VALUE{32 * 2.F * 128 * 32768};
+    multiplier = static_cast<uint16_t>(MAX_VALUE / width / numLeds);
+    location = (position * numLeds * multiplier) / 32768;
+}
+
+int32_t BumpShape::getInt(int32_t led) const {
+    auto distance{static_cast<uint32_t>(abs((led * multiplier) - location))};
+    auto index{distance >> 7};
+
+    if (index >= (sizeof(BUMP_SHAPE) / sizeof(BUMP_SHAPE[0]) - 1)) return 0;
+
+    auto modFactor{distance & 0x3F};
+    return static_cast<int32_t>((BUMP_SHAPE[index] * (128 - modFactor)) + (BUMP_SHAPE[index + 1] * modFactor));
+}
+
+void BumpShape::getInts(std::span<int32_t> out, int32_t ledBegin) const {
+    for (size_t idx{0}; idx < out.size(); idx++) {
+        auto distance{static_cast<uint32_t>(abs(((ledBegin + static_cast<int32_t>(idx)) * multiplier) - location))};
+        auto index{distance >> 7};
+
+        if (index >= (sizeof(BUMP_SHAPE) / sizeof(BUMP_SHAPE[0]) - 1)) {
+            out[idx] = 0;
+            continue;
+        }
+
+        auto modFactor{distance & 0x3F};
+        out[idx] = static_cast<int32_t>((BUMP_SHAPE[index] * (128 - modFactor)) + (BUMP_SHAPE[index + 1] * modFactor));
+    }
+}
+
+// The element's body goes in the *Impl function, so it can be skipped when the
+// function is bound (see FunctionStyle::bindValues()), and whole-blade calls
+// can be profiled. Per-LED getInt() isn't, a timer per LED would cost more
+// than most elements do.
+#define RUN(varname) \
+    virtual void run(StylePreview::Blade& blade) override { if (isBound()) return; PROFILE_STYLE("run"); runImpl(blade); } \
+    void runImpl(StylePreview::Blade& varname)
+#define GETINT(varname) \
+    virtual int32_t getInt(int32_t led) override { if (isBound()) return getBoundInt(led); return getIntImpl(led); } \
+    int32_t getIntImpl(int32_t varname)
+#define RUN3D(varname) virtual void run(StylePreview::Blade& varname) override
 #define GETINT3D(varname) virtual int32_t getInt(const Vector3D& varname) override
+#define GETINTS(outvarname, beginvarname) \
+    virtual void getInts(std::span<int32_t> out, int32_t ledBegin) override { \
+        if (isBound()) { getBoundInts(out, ledBegin); return; } \
+        PROFILE_STYLE("getInts"); \
+        getIntsImpl(out, ledBegin); \
+    } \
+    void getIntsImpl(std::span<int32_t> outvarname, int32_t beginvarname)
+#define VARIANCE(variance) [[nodiscard]] virtual Variance getVariance() const override { return Variance::variance; }
 
 #define FUNCTEMPLATE(styleType, osName, humanName, params, ...) \
     class osName : public styleType { \
@@ -100,16 +181,19 @@ const StyleMap& Function3DStyle::getMap() { return map; }
 // return value: INTEGER
 FUNC(Int, "Number",
         PARAMS(
-            new NumberParam("")
+            NumberParam("")
             ),
+    VARIANCE(CONSTANT)
     RUN() {}
     GETINT() { return getParamNumber(0); }
+    GETINTS(out, ) { std::fill(out.begin(), out.end(), getParamNumber(0)); }
     )
 
 // Usage: AltF
 // return value: INTEGER
 // Returns current_alternative for use in ColorSelect<>, TrSelect<> or IntSelect<>
 FUNC(AltF, "Get Current Alt", PARAMS(), 
+    VARIANCE(PER_FRAME)
     RUN() {} 
     GETINT() { return curAlt; }
     
@@ -122,6 +206,7 @@ FUNC(AltF, "Get Current Alt", PARAMS(),
 // Enables Bidirectional synchronization between ALT and VARIANCE.
 // If variance changes, so does alt, if alt changes, so does variance.
 FUNC(SyncAltToVarianceF, "Sync Alt and Variance", PARAMS(),
+    VARIANCE(CONSTANT)
     RUN() {}
     GETINT() { return 0; }
     )
@@ -135,8 +220,10 @@ FUNC(SyncAltToVarianceF, "Sync Alt and Variance", PARAMS(),
 // Returns 0-32768 based on battery level.
 // returned value: INTEGER
 FUNC(BatteryLevel, "Battery Level", PARAMS(),
+        VARIANCE(PER_FRAME)
         RUN(blade) { value = blade.batteryLevel; }
         GETINT() { return value; }
+        GETINTS(out, ) { std::fill(out.begin(), out.end(), value); }
 
         private: 
             uint16_t value;
@@ -155,19 +242,21 @@ FUNC(BatteryLevel, "Battery Level", PARAMS(),
 // returned value: FUNCTION, same for all leds
 FUNC(BladeAngle, "Blade Angle",
         PARAMS(
-            new NumberParam("Min", 0),
-            new NumberParam("Max", 32768)
+            NumberParam("Min", 0),
+            NumberParam("Max", 32768)
             ),
 
+        VARIANCE(PER_FRAME)
         RUN() {}
         GETINT() { return 0; }
     )
 
 FUNC(BladeAngleX, "Blade Angle",
         PARAMS(
-            new StyleParam("Min", FUNCTION, get("Int")(PARAMVEC(0))),
-            new StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768)))
+            StyleParam("Min", FUNCTION, get("Int")(PARAMVEC(0))),
+            StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768)))
             ),
+        VARIANCE(PER_FRAME)
         RUN() {}
         GETINT() { return 0; }
     )
@@ -190,14 +279,15 @@ FUNC(BladeAngleX, "Blade Angle",
 // other than a blast effect.
 FUNC(BlastF, "Blast",
         PARAMS(
-            new NumberParam("Fadeout (ms)", 200),
-            new NumberParam("Wave Size", 100),
-            new NumberParam("Wave Time (ms)", 400),
-            new StyleParam("Trigger Effect", EFFECT, EffectStyle::get("BLAST")(PARAMVEC()))
+            NumberParam("Fadeout (ms)", 200),
+            NumberParam("Wave Size", 100),
+            NumberParam("Wave Time (ms)", 400),
+            StyleParam("Trigger Effect", EFFECT, EffectStyle::get("BLAST")(PARAMVEC()))
             ),
         RUN(blade) {
             numLeds = blade.numLeds;
             effects = blade.getEffects();
+            now = blade.getTimeMicros();
 
             fadeTime = getParamNumber(0);
             waveSize = getParamNumber(1);
@@ -208,7 +298,7 @@ FUNC(BlastF, "Blast",
             uint32_t mix{0};
             for (const auto& effect : effects) {
                 if (effect.type != thisEffect) continue;
-                auto timeDelta{Utility::getTimeMicros() - effect.startMicros};
+                auto timeDelta{now - effect.startMicros};
                 constexpr auto SCALE{1000};
                 auto fadeFactor{SCALE - (timeDelta / fadeTime)};
                 if (fadeFactor > 0) {
@@ -219,6 +309,28 @@ FUNC(BlastF, "Blast",
             }
             return std::min(mix << 7, static_cast<uint32_t>(32768));
         }
+        GETINTS(out, ledBegin) {
+            // Same as getInt(), but with the per-effect work done once for the whole run
+            mixes.assign(out.size(), 0);
+            for (const auto& effect : effects) {
+                if (effect.type != thisEffect) continue;
+                auto timeDelta{now - effect.startMicros};
+                constexpr auto SCALE{1000};
+                auto fadeFactor{SCALE - (timeDelta / fadeTime)};
+                if (fadeFactor <= 0) continue;
+
+                const auto waveOffset{timeDelta / (waveTime * static_cast<float>(SCALE))};
+                for (size_t idx{0}; idx < out.size(); idx++) {
+                    auto led{ledBegin + static_cast<int32_t>(idx)};
+                    auto dist{fabsf(effect.location - (led / static_cast<float>(numLeds)))};
+                    auto index{static_cast<uint32_t>(fabsf(dist - waveOffset) * waveSize)};
+                    if (index <= 32) mixes[idx] += (BLAST_HUMP[index] * fadeFactor) / SCALE;
+                }
+            }
+            for (size_t idx{0}; idx < out.size(); idx++) {
+                out[idx] = static_cast<int32_t>(std::min(mixes[idx] << 7, static_cast<uint32_t>(32768)));
+            }
+        }
 
         private:
             uint16_t fadeTime;
@@ -227,7 +339,9 @@ FUNC(BlastF, "Blast",
             Effect thisEffect;
 
             uint16_t numLeds;
-            std::vector<StylePreview::BladeEffect> effects;
+            uint64_t now{0};
+            std::span<const StylePreview::BladeEffect> effects;
+            std::vector<uint32_t> mixes;
     )
 
 // Usage: BlastFadeoutF<FADEOUT_MS, EFFECT>
@@ -239,33 +353,37 @@ FUNC(BlastF, "Blast",
 // FADEOUT_MS milliseconds.
 FUNC(BlastFadeoutF, "Blast Fadeout",
         PARAMS(
-            new NumberParam("Fade Time (ms)", 250),
-            new StyleParam("Trigger Effect", EFFECT, EffectStyle::get("BLAST")(PARAMVEC()))
+            NumberParam("Fade Time (ms)", 250),
+            StyleParam("Trigger Effect", EFFECT, EffectStyle::get("BLAST")(PARAMVEC()))
             ),
+        VARIANCE(PER_FRAME)
         RUN(blade) {
             fadeTime = getParamNumber(0);
             thisEffect = static_cast<const EffectStyle*>(getParamStyle(1))->effect;
 
             numLeds = blade.numLeds;
             effects = blade.getEffects();
+            now = blade.getTimeMicros();
         }
         GETINT() {
             if (effects.size() == 0) return 0;
             uint32_t mix{0};
             for (const auto& effect : effects) {
                 if (effect.type != thisEffect) continue;
-                auto timeDelta{Utility::getTimeMicros() - effect.startMicros};
+                auto timeDelta{now - effect.startMicros};
                 auto fadeFactor{1000 - (timeDelta / fadeTime)};
                 if (fadeFactor > 0) mix += (32768 * fadeFactor) / 1000;
             }
             return std::min(mix, static_cast<uint32_t>(32768));
         }
+        GETINTS(out, ) { std::fill(out.begin(), out.end(), getInt(0)); }
         private:
             uint16_t fadeTime;
             Effect thisEffect{Effect::NONE};
 
             uint16_t numLeds;
-            std::vector<StylePreview::BladeEffect> effects;
+            uint64_t now{0};
+            std::span<const StylePreview::BladeEffect> effects;
     )
 
 // Usage: OriginalBlastF<EFFECT>
@@ -275,13 +393,14 @@ FUNC(BlastFadeoutF, "Blast Fadeout",
 // returns up to 32768 when the selected effect occurs.
 FUNC(OriginalBlastF, "Original Blast",
         PARAMS(
-            new StyleParam("Trigger Effect", EFFECT, EffectStyle::get("BLAST")(PARAMVEC()))
+            StyleParam("Trigger Effect", EFFECT, EffectStyle::get("BLAST")(PARAMVEC()))
             ),
         RUN(blade) {
             thisEffect = static_cast<const EffectStyle*>(getParamStyle(0))->effect;
 
             numLeds = blade.numLeds;
             effects = blade.getEffects();
+            now = blade.getTimeMicros();
         }
         GETINT(led) {
             if (effects.size() == 0) return 0;
@@ -295,7 +414,7 @@ FUNC(OriginalBlastF, "Original Blast",
                 if (effect.type != thisEffect) continue;
 
                 float offset{effect.location - (led / static_cast<float>(numLeds)) * SCALE};
-                auto timeDelta{Utility::getTimeMicros() - effect.startMicros};
+                auto timeDelta{now - effect.startMicros};
                 auto timeFactor{TIME_OFFSET + (timeDelta / TIME_SCALE)};
 
                 if (offset == 0.F) mix += INTENSITY_SCALE / (timeFactor * timeFactor);
@@ -307,7 +426,8 @@ FUNC(OriginalBlastF, "Original Blast",
             Effect thisEffect{Effect::NONE};
 
             uint16_t numLeds;
-            std::vector<StylePreview::BladeEffect> effects;
+            uint64_t now{0};
+            std::span<const StylePreview::BladeEffect> effects;
     )
 
 // Usage: BlinkingF<A, B, BLINK_MILLIS_FUNC, BLINK_PROMILLE_FUNC>
@@ -327,18 +447,19 @@ FUNC(OriginalBlastF, "Original Blast",
 // It's clearly not right, but based on the actual code the following seems correct:
 FUNC(BlinkingF, "Blinking",
         PARAMS(
-            new StyleParam("Time (ms)", FUNCTION, get("Int")(PARAMVEC(1000))),
-            new StyleParam("Distribution", FUNCTION, get("Int")(PARAMVEC(500)))
+            StyleParam("Time (ms)", FUNCTION, get("Int")(PARAMVEC(1000))),
+            StyleParam("Distribution", FUNCTION, get("Int")(PARAMVEC(500)))
             ),
+        VARIANCE(PER_FRAME)
         RUN(blade) {
             pulseTime = const_cast<decltype(pulseTime)>(static_cast<const FunctionStyle*>(getParamStyle(0)));
             pulseDist = const_cast<decltype(pulseDist)>(static_cast<const FunctionStyle*>(getParamStyle(1)));
 
             pulseTime->run(blade);
             pulseDist->run(blade);
+            now = blade.getTimeMicros();
         }
         GETINT() {
-            auto now{Utility::getTimeMicros()};
             auto pulseMillis{static_cast<uint32_t>(pulseTime->getInt(0))};
             if (pulseMillis <= 0) return 0;
 
@@ -355,6 +476,7 @@ FUNC(BlinkingF, "Blinking",
             FunctionStyle* pulseTime{nullptr};
             FunctionStyle* pulseDist{nullptr};
 
+            uint64_t now{0};
             uint32_t pulseStartMicros{0};
     )
 
@@ -364,23 +486,34 @@ FUNC(BlinkingF, "Blinking",
 // GRADE controls how similar nearby pixels are.
 FUNC(BrownNoiseF, "Brown Noise",
         PARAMS(
-            new StyleParam("Grade", FUNCTION, nullptr)
+            StyleParam("Grade", FUNCTION, nullptr)
             ),
         RUN(blade) {
             grade = const_cast<FunctionStyle*>(static_cast<const FunctionStyle*>(getParamStyle(0)));
             grade->run(blade);
+            random = &blade.getRandom();
 
-            mix = ProffieUtils::random() % 32768; // Not sure what random Fredrik uses... but this isn't inclusive
+            mix = random->next() % 32768; // Not sure what random Fredrik uses... but this isn't inclusive
         }
-        GETINT(led) {
-            auto gradeValue{grade->getInt(led)};
-            auto rawMixValue{static_cast<uint16_t>(mix + (ProffieUtils::random() % ((gradeValue * 2) + 1)) - gradeValue)};
-            // Fredrik's clamps the negative but here I use a uint, so no need.
-            mix = std::min<uint16_t>(32768, rawMixValue);
-            return mix;
+        GETINT(led) { return step(grade->getInt(led), random->next()); }
+        GETINTS(out, ledBegin) {
+            // Pull the whole span of randoms at once, the walk itself has to stay in order.
+            randoms.resize(out.size());
+            random->fill(randoms);
+            grade->getInts(out, ledBegin);
+            for (size_t idx{0}; idx < out.size(); idx++) out[idx] = step(out[idx], randoms[idx]);
         }
         private:
+            int32_t step(int32_t gradeValue, uint32_t randomValue) {
+                auto rawMixValue{static_cast<uint16_t>(mix + (randomValue % ((gradeValue * 2) + 1)) - gradeValue)};
+                // Fredrik's clamps the negative but here I use a uint, so no need.
+                mix = std::min<uint16_t>(32768, rawMixValue);
+                return mix;
+            }
+
             uint16_t mix;
+            ProffieUtils::Random* random{nullptr};
+            std::vector<uint32_t> randoms;
             FunctionStyle* grade{nullptr};
     )
 
@@ -391,23 +524,25 @@ FUNC(BrownNoiseF, "Brown Noise",
 // SPEED controls how quickly the value changes.
 FUNC(SlowNoise, "Slow Noise",
         PARAMS(
-            new StyleParam("Speed", FUNCTION, nullptr)
+            StyleParam("Speed", FUNCTION, nullptr)
             ),
+        VARIANCE(PER_FRAME)
         RUN(blade) {
             // This happens in the ctor in ProffieOS, hence the magic number and assignment
-            if (value == 0xFFFF) value = ProffieUtils::random() % 32768;
+            if (value == 0xFFFF) value = blade.getRandom().next() % 32768;
 
             auto speed{const_cast<FunctionStyle*>(static_cast<const FunctionStyle*>(getParamStyle(0)))};
             speed->run(blade);
-            auto now{Utility::getTimeMS()};
+            auto now{blade.getTimeMS()};
             auto delta{now - lastMillis};
             if (delta > 1000) delta = 1;
             lastMillis = now;
             auto speedValue{speed->getInt(0)};
 
-            while (delta--) value = std::max<uint16_t>(value + ((ProffieUtils::random() % ((speedValue * 2)  + 1)) - speedValue), 0);
+            while (delta--) value = std::max<uint16_t>(value + ((blade.getRandom().next() % ((speedValue * 2)  + 1)) - speedValue), 0);
         }
         GETINT() { return value; }
+        GETINTS(out, ) { std::fill(out.begin(), out.end(), value); }
         private:
             uint16_t value{0xFFFF};
             uint64_t lastMillis{0};
@@ -422,8 +557,8 @@ FUNC(SlowNoise, "Slow Noise",
 // BUMP_POSITION, BUMP_WIDTH_FRACTION: INTEGER
 FUNC(Bump, "Bump",
         PARAMS(
-            new StyleParam("Position", FUNCTION, get("Int")(PARAMVEC(0))),
-            new StyleParam("Width", FUNCTION, get("Int")(PARAMVEC(16385)))
+            StyleParam("Position", FUNCTION, get("Int")(PARAMVEC(0))),
+            StyleParam("Width", FUNCTION, get("Int")(PARAMVEC(16385)))
             ),
         RUN(blade) {
             pos = const_cast<FunctionStyle*>(static_cast<const FunctionStyle*>(getParamStyle(0)));
@@ -432,32 +567,15 @@ FUNC(Bump, "Bump",
             pos->run(blade);
             width->run(blade);
 
-            auto widthValue{width->getInt(0)};
-            if (widthValue == 0) {
-                multiplier = 1;
-                location = -10000;
-                return;
-            }
-
-            constexpr auto MAX_VALUE{32 * 2.F * 128 * 32768};
-            multiplier = static_cast<uint16_t>(MAX_VALUE / widthValue / blade.numLeds);
-            location = (pos->getInt(0) * blade.numLeds * multiplier) / 32768;
-        }
-        GETINT(led) {
-            auto distance{static_cast<uint32_t>(abs((static_cast<int32_t>(led) * multiplier) - location))};
-            auto index{distance >> 7};
-
-            if (index >= (sizeof(BUMP_SHAPE) / sizeof(BUMP_SHAPE[0]) - 1)) return 0;
-
-            auto modFactor{distance & 0x3F};
-            return (BUMP_SHAPE[index] * (128 - modFactor)) + (BUMP_SHAPE[index + 1] * modFactor);
+            shape = BumpShape(pos->getInt(0), width->getInt(0), blade.numLeds);
         }
+        GETINT(led) { return shape.getInt(led); }
+        GETINTS(out, ledBegin) { shape.getInts(out, ledBegin); }
         private:
             FunctionStyle* pos;
             FunctionStyle* width;
 
-            int32_t location;
-            int32_t multiplier;
+            BumpShape shape;
     )
 
 // Usage: HumpFlickerFX<FUNCTION>
@@ -471,7 +589,7 @@ FUNC(Bump, "Bump",
 // while small values look more like speckles.
 FUNC(HumpFlickerF, "Hump Flicker",
         PARAMS(
-            new NumberParam("Hump Width", FUNCTION)
+            NumberParam("Hump Width", FUNCTION)
             ),
         RUN() {}
         GETINT() {}
@@ -479,7 +597,7 @@ FUNC(HumpFlickerF, "Hump Flicker",
 
 FUNC(HumpFlickerFX, "Hump Flicker",
         PARAMS(
-            new StyleParam("Hump Width", FUNCTION, nullptr)
+            StyleParam("Hump Width", FUNCTION, nullptr)
             ),
         RUN() {}
         GETINT() {}
@@ -492,7 +610,7 @@ FUNC(HumpFlickerFX, "Hump Flicker",
 //
 FUNC(CenterDistF, "Center Distribution",
         PARAMS(
-            new StyleParam("Center", FUNCTION, get("Int")(PARAMVEC(16384)))
+            StyleParam("Center", FUNCTION, get("Int")(PARAMVEC(16384)))
             ),
         RUN() {}
         GETINT() {}
@@ -504,8 +622,8 @@ FUNC(CenterDistF, "Center Distribution",
 // return value: FUNCTION, same for all LEDs
 FUNC(ChangeSlowly, "Change Slowly",
         PARAMS(
-            new StyleParam("Input", FUNCTION, nullptr),
-            new StyleParam("Speed", FUNCTION, get("Int")(PARAMVEC(32768))),
+            StyleParam("Input", FUNCTION, nullptr),
+            StyleParam("Speed", FUNCTION, get("Int")(PARAMVEC(32768))),
             ),
         RUN() {}
         GETINT() {}
@@ -523,8 +641,8 @@ FUNC(ChangeSlowly, "Change Slowly",
 // and 0 for the rest of the LEDs.
 FUNC(CircularSectionF, "Circular Section",
         PARAMS(
-            new StyleParam("Position", FUNCTION, get("Int")(PARAMVEC(0))),
-            new StyleParam("Fraction", FUNCTION, get("Int")(PARAMVEC(16384))),
+            StyleParam("Position", FUNCTION, get("Int")(PARAMVEC(0))),
+            StyleParam("Fraction", FUNCTION, get("Int")(PARAMVEC(16384))),
             ),
         RUN() {}
         GETINT() {}
@@ -538,9 +656,9 @@ FUNC(CircularSectionF, "Circular Section",
 // return value: INTEGER
 FUNC(ClampF, "Clamp",
         PARAMS(
-            new StyleParam("Input", FUNCTION, nullptr),
-            new NumberParam("Min", 0),
-            new NumberParam("Max", 32768)
+            StyleParam("Input", FUNCTION, nullptr),
+            NumberParam("Min", 0),
+            NumberParam("Max", 32768)
             ),
         RUN() {}
         GETINT() {}
@@ -548,9 +666,9 @@ FUNC(ClampF, "Clamp",
 
 FUNC(ClampFX, "Clamp",
         PARAMS(
-            new StyleParam("Input", FUNCTION, nullptr),
-            new StyleParam("Min", FUNCTION, get("Int")(PARAMVEC(0))),
-            new StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768))),
+            StyleParam("Input", FUNCTION, nullptr),
+            StyleParam("Min", FUNCTION, get("Int")(PARAMVEC(0))),
+            StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768))),
             ),
         RUN() {}
         GETINT() {}
@@ -564,8 +682,8 @@ FUNC(ClampFX, "Clamp",
 // return value: INTEGER
 FUNC(ClashImpactF, "Clash Impact",
         PARAMS(
-            new NumberParam("Min", 0),
-            new NumberParam("Max", 32768)
+            NumberParam("Min", 0),
+            NumberParam("Max", 32768)
             ),
         RUN() {}
         GETINT() {}
@@ -573,8 +691,8 @@ FUNC(ClashImpactF, "Clash Impact",
 
 FUNC(ClashImpactFX, "Clash Impact",
         PARAMS(
-            new StyleParam("Min", FUNCTION, get("Int")(PARAMVEC(0))),
-            new StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768))),
+            StyleParam("Min", FUNCTION, get("Int")(PARAMVEC(0))),
+            StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768))),
             ),
         RUN() {}
         GETINT() {}
@@ -589,8 +707,8 @@ FUNC(ClashImpactFX, "Clash Impact",
 // (it divides the result by 32768) while Divide<> doesn't, it just returns F / V
 FUNC(Divide, "Divide",
         PARAMS(
-            new StyleParam("Numerator", FUNCTION, nullptr),
-            new StyleParam("Denominator", FUNCTION, nullptr),
+            StyleParam("Numerator", FUNCTION, nullptr),
+            StyleParam("Denominator", FUNCTION, nullptr),
             ),
         RUN() {}
         GETINT() {}
@@ -601,7 +719,7 @@ FUNC(Divide, "Divide",
 // Returns 32768 once for each time the given effect occurs.
 FUNC(EffectPulse, "Pulse On Effect",
         PARAMS(
-            new StyleParam("Trigger Effect", EFFECT, nullptr)
+            StyleParam("Trigger Effect", EFFECT, nullptr)
             
             ),
         RUN() {}
@@ -613,7 +731,7 @@ FUNC(EffectPulse, "Pulse On Effect",
 // Returns 32768 once for each time the given lockup occurs.
 FUNC(LockupPulseF, "Pulse On Lockup",
         PARAMS(
-            new StyleParam("Trigger Lockup", LOCKUPTYPE, nullptr)
+            StyleParam("Trigger Lockup", LOCKUPTYPE, nullptr)
             ),
         RUN() {}
         GETINT() {}
@@ -628,10 +746,10 @@ FUNC(LockupPulseF, "Pulse On Lockup",
 // Resets back to zero when RESET_PULSE occurs.
 FUNC(IncrementWithReset, "Increment With Reset",
         PARAMS(
-            new StyleParam("Increment Pulse",   FUNCTION, nullptr),
-            new StyleParam("Pulse Reset", 	    FUNCTION, nullptr),
-            new StyleParam("Max", 			    FUNCTION, get("Int")(PARAMVEC(32768))),
-            new StyleParam("Increment", 		FUNCTION, get("Int")(PARAMVEC(1)))
+            StyleParam("Increment Pulse",   FUNCTION, nullptr),
+            StyleParam("Pulse Reset", 	    FUNCTION, nullptr),
+            StyleParam("Max", 			    FUNCTION, get("Int")(PARAMVEC(32768))),
+            StyleParam("Increment", 		FUNCTION, get("Int")(PARAMVEC(1)))
             ),
         RUN() {}
         GETINT() {}
@@ -645,9 +763,9 @@ FUNC(IncrementWithReset, "Increment With Reset",
 // return value: INTEGER
 FUNC(EffectIncrementF, "Increment On Effect",
         PARAMS(
-            new StyleParam("Trigger Effect", EFFECT, nullptr),
-            new StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768))),
-            new StyleParam("Increment", FUNCTION, get("Int")(PARAMVEC(1)))
+            StyleParam("Trigger Effect", EFFECT, nullptr),
+            StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768))),
+            StyleParam("Increment", FUNCTION, get("Int")(PARAMVEC(1)))
             ),
         RUN() {}
         GETINT() {}
@@ -664,7 +782,7 @@ FUNC(EffectIncrementF, "Increment On Effect",
 // then it will automatically use the right effect.
 FUNC(EffectPosition, "Effect Position",
         PARAMS(
-            new StyleParam("Effect", EFFECT, nullptr)
+            StyleParam("Effect", EFFECT, nullptr)
             ),
         RUN() {}
         GETINT() {}
@@ -677,9 +795,9 @@ FUNC(EffectPosition, "Effect Position",
 // return value: FUNCTION, same for all LEDs
 FUNC(HoldPeakF, "Hold Peak Value",
         PARAMS(
-            new StyleParam("Input", FUNCTION, nullptr),
-            new StyleParam("Hold Time (ms)", FUNCTION, get("Int")(PARAMVEC(0))),
-            new StyleParam("Ramp Down Speed", FUNCTION, get("Int")(PARAMVEC(0))),
+            StyleParam("Input", FUNCTION, nullptr),
+            StyleParam("Hold Time (ms)", FUNCTION, get("Int")(PARAMVEC(0))),
+            StyleParam("Ramp Down Speed", FUNCTION, get("Int")(PARAMVEC(0))),
             ),
         RUN() {}
         GETINT() {}
@@ -691,8 +809,8 @@ FUNC(HoldPeakF, "Hold Peak Value",
 // return value: INTEGER
 FUNC(Ifon, "If On",
         PARAMS(
-            new StyleParam("Value if On", FUNCTION, get("Int")(PARAMVEC(32768))),
-            new StyleParam("Value if Off", FUNCTION, get("Int")(PARAMVEC(0))),
+            StyleParam("Value if On", FUNCTION, get("Int")(PARAMVEC(32768))),
+            StyleParam("Value if Off", FUNCTION, get("Int")(PARAMVEC(0))),
             ),
         RUN() {}
         GETINT() {}
@@ -706,8 +824,8 @@ FUNC(Ifon, "If On",
 // NEED A BETTER HUMAN NAME
 FUNC(InOutFunc, "In Out Func",
         PARAMS(
-            new NumberParam("Out Time (ms)", 300),
-            new NumberParam("In Time (ms)", 600)
+            NumberParam("Out Time (ms)", 300),
+            NumberParam("In Time (ms)", 600)
             ),
         RUN() {}
         GETINT() {}
@@ -715,8 +833,8 @@ FUNC(InOutFunc, "In Out Func",
 
 FUNC(InOutFuncX, "In Out Func",
         PARAMS(
-            new StyleParam("Out Time (ms)", FUNCTION, get("Int")(PARAMVEC(300))),
-            new StyleParam("In Time (ms)", FUNCTION, get("Int")(PARAMVEC(600))),
+            StyleParam("Out Time (ms)", FUNCTION, get("Int")(PARAMVEC(300))),
+            StyleParam("In Time (ms)", FUNCTION, get("Int")(PARAMVEC(600))),
             ),
         RUN() {}
         GETINT() {}
@@ -727,9 +845,9 @@ FUNC(InOutFuncX, "In Out Func",
 // NEED A BETTER HUMAN NAME
 FUNC(InOutFuncTD, "In Out Func TD",
         PARAMS(
-            new NumberParam("Out Time (ms)"),
-            new NumberParam("In Time (ms)"),
-            new NumberParam("Explode Time (ms)")
+            NumberParam("Out Time (ms)"),
+            NumberParam("In Time (ms)"),
+            NumberParam("Explode Time (ms)")
             ),
         RUN() {}
         GETINT() {}
@@ -739,8 +857,8 @@ FUNC(InOutFuncTD, "In Out Func TD",
 // NEED A BETTER HUMAN NAME
 FUNC(InOutHelperF, "In Out Helper",
         PARAMS(
-            new StyleParam("Input", FUNCTION, nullptr),
-            new BoolParam("Allow Disable", true)
+            StyleParam("Input", FUNCTION, nullptr),
+            BoolParam("Allow Disable", true)
             ),
         RUN() {}
         GETINT() {}
@@ -755,9 +873,9 @@ FUNC(InOutHelperF, "In Out Helper",
 // The documentation is incorrect, the name does end in F
 FUNC(IncrementModuloF, "Increment With Wrap",
         PARAMS(
-            new StyleParam("Pulse Input", FUNCTION, nullptr),
-            new StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768))),
-            new StyleParam("Increment", FUNCTION, get("Int")(PARAMVEC(1))),
+            StyleParam("Pulse Input", FUNCTION, nullptr),
+            StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768))),
+            StyleParam("Increment", FUNCTION, get("Int")(PARAMVEC(1))),
             ),
         RUN() {}
         GETINT() {}
@@ -773,9 +891,9 @@ FUNC(IncrementModuloF, "Increment With Wrap",
 // BETTER HUMAN NAME?
 FUNC(ThresholdPulseF, "Pulse on Threshold",
         PARAMS(
-            new StyleParam("Input", FUNCTION, nullptr),
-            new StyleParam("Threshold", FUNCTION, get("Int")(PARAMVEC(32768))),
-            new StyleParam("Hysteresis %", FUNCTION, get("Int")(PARAMVEC(66))),
+            StyleParam("Input", FUNCTION, nullptr),
+            StyleParam("Threshold", FUNCTION, get("Int")(PARAMVEC(32768))),
+            StyleParam("Hysteresis %", FUNCTION, get("Int")(PARAMVEC(66))),
             ),
         RUN() {}
         GETINT() {}
@@ -792,11 +910,11 @@ FUNC(ThresholdPulseF, "Pulse on Threshold",
 // This function may break up SwingSpeed effects or other continuous responsive functions.
 FUNC(IncrementF, "Increment on Input",
         PARAMS(
-            new StyleParam("Input", FUNCTION, nullptr),
-            new StyleParam("Increment Threshold", FUNCTION, get("Int")(PARAMVEC(32768))),
-            new StyleParam("Max Value", FUNCTION, get("Int")(PARAMVEC(32768))),
-            new StyleParam("Increment", FUNCTION, get("Int")(PARAMVEC(1))),
-            new StyleParam("Hysteresis %", FUNCTION, get("Int")(PARAMVEC(66))),
+            StyleParam("Input", FUNCTION, nullptr),
+            StyleParam("Increment Threshold", FUNCTION, get("Int")(PARAMVEC(32768))),
+            StyleParam("Max Value", FUNCTION, get("Int")(PARAMVEC(32768))),
+            StyleParam("Increment", FUNCTION, get("Int")(PARAMVEC(1))),
+            StyleParam("Hysteresis %", FUNCTION, get("Int")(PARAMVEC(66))),
             ),
         RUN() {}
         GETINT() {}
@@ -818,8 +936,8 @@ FUNC(IncrementF, "Increment on Input",
 // RgbArg does the same thing...
 FUNC(IntArg, "Number Argument",
         PARAMS(
-            new StyleParam("Arg", ARGUMENT, nullptr),
-            new NumberParam("Default Value")
+            StyleParam("Arg", ARGUMENT, nullptr),
+            NumberParam("Default Value")
             ),
         RUN() {}
         GETINT() {}
@@ -833,8 +951,8 @@ FUNC(IntArg, "Number Argument",
 // return value: INTEGER
 FUNC(IntSelect, "Number Select",
         PARAMS(
-            new StyleParam("Selection", FUNCTION, nullptr),
-            new NumberParam("Number #", 0, VARIADIC)
+            StyleParam("Selection", FUNCTION, nullptr),
+            NumberParam("Number #", 0, VARIADIC)
             ),
         RUN() {}
         GETINT() {}
@@ -846,9 +964,9 @@ FUNC(IntSelect, "Number Select",
 // return value: INTEGER
 FUNC(IsBetween, "Is Between",
         PARAMS(
-            new StyleParam("Input", FUNCTION, nullptr),
-            new StyleParam("Min", FUNCTION, get("Int")(PARAMVEC(0))),
-            new StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768))),
+            StyleParam("Input", FUNCTION, nullptr),
+            StyleParam("Min", FUNCTION, get("Int")(PARAMVEC(0))),
+            StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768))),
             ),
         RUN() {}
         GETINT() {}
@@ -861,8 +979,8 @@ FUNC(IsBetween, "Is Between",
 // return value: INTEGER
 FUNC(IsLessThan, "Is Less Than",
         PARAMS(
-            new StyleParam("Input", FUNCTION, nullptr),
-            new StyleParam("Compare To", FUNCTION, nullptr)
+            StyleParam("Input", FUNCTION, nullptr),
+            StyleParam("Compare To", FUNCTION, nullptr)
             ),
         RUN() {}
         GETINT() {}
@@ -870,8 +988,8 @@ FUNC(IsLessThan, "Is Less Than",
 
 FUNC(IsGreaterThan, "Is Greater Than",
         PARAMS(
-            new StyleParam("Input", FUNCTION, nullptr),
-            new StyleParam("Compare To", FUNCTION, nullptr)
+            StyleParam("Input", FUNCTION, nullptr),
+            StyleParam("Compare To", FUNCTION, nullptr)
             ),
         RUN() {}
         GETINT() {}
@@ -896,8 +1014,8 @@ FUNC(IsGreaterThan, "Is Greater Than",
 // creates a "block" of pixels at POSITION taking up FRACTION of blade
 FUNC(LinearSectionF, "Linear Section",
         PARAMS(
-            new StyleParam("Position", FUNCTION, get("Int")(PARAMVEC(16384))),
-            new StyleParam("Section Size", FUNCTION, get("Int")(PARAMVEC(16384))),
+            StyleParam("Position", FUNCTION, get("Int")(PARAMVEC(16384))),
+            StyleParam("Section Size", FUNCTION, get("Int")(PARAMVEC(16384))),
             ),
         RUN() {}
         GETINT() {}
@@ -916,10 +1034,10 @@ FUNC(LinearSectionF, "Linear Section",
 // position into a lighted up section.
 FUNC(MarbleF, "Marble Simulation",
         PARAMS(
-            new StyleParam("Direction Offset",  FUNCTION, get("Int")(PARAMVEC(0))),
-            new StyleParam("Friction",          FUNCTION, get("Int")(PARAMVEC(16384))),
-            new StyleParam("Acceleration",      FUNCTION, get("Int")(PARAMVEC(16384))),
-            new StyleParam("Gravity",           FUNCTION, get("Int")(PARAMVEC(16384))),
+            StyleParam("Direction Offset",  FUNCTION, get("Int")(PARAMVEC(0))),
+            StyleParam("Friction",          FUNCTION, get("Int")(PARAMVEC(16384))),
+            StyleParam("Acceleration",      FUNCTION, get("Int")(PARAMVEC(16384))),
+            StyleParam("Gravity",           FUNCTION, get("Int")(PARAMVEC(16384))),
         ),
         RUN() {}
         GETINT() {}
@@ -933,8 +1051,8 @@ FUNC(MarbleF, "Marble Simulation",
 // returns Integer
 FUNC(ModF, "Modulo",
         PARAMS(
-            new StyleParam("Input", FUNCTION, nullptr),
-            new StyleParam("Divisor", FUNCTION, nullptr)
+            StyleParam("Input", FUNCTION, nullptr),
+            StyleParam("Divisor", FUNCTION, nullptr)
             ),
         RUN() {}
         GETINT() {}
@@ -950,8 +1068,8 @@ FUNC(ModF, "Modulo",
 // return value: INTEGER
 FUNC(Mult, "Multiply",
         PARAMS(
-            new StyleParam("Factor 1", FUNCTION, nullptr),
-            new StyleParam("Factor 2", FUNCTION, nullptr)
+            StyleParam("Factor 1", FUNCTION, nullptr),
+            StyleParam("Factor 2", FUNCTION, nullptr)
             ),
         RUN() {}
         GETINT() {}
@@ -966,8 +1084,8 @@ FUNC(Mult, "Multiply",
 // return value: INTEGER
 FUNC(Percentage, "Percentage",
         PARAMS(
-            new StyleParam("Input", FUNCTION, nullptr),
-            new StyleParam("Percent", FUNCTION, nullptr)
+            StyleParam("Input", FUNCTION, nullptr),
+            StyleParam("Percent", FUNCTION, nullptr)
             ),
         RUN() {}
         GETINT() {}
@@ -982,7 +1100,7 @@ FUNC(Percentage, "Percentage",
 // to create a flash of color or white when the blade ignites.
 FUNC(OnSparkF, "On Spark",
         PARAMS(
-            new StyleParam("Fade Time (ms)", FUNCTION, get("Int")(PARAMVEC(200)))
+            StyleParam("Fade Time (ms)", FUNCTION, get("Int")(PARAMVEC(200)))
             ),
         RUN() {}
         GETINT() {}
@@ -1023,7 +1141,7 @@ FUNC(RandomPerLEDF, "Random Per LED", PARAMS(),
 // RandomEffect makes more sense for a name to me...
 FUNC(EffectRandom, "Random On Effect",
         PARAMS(
-            new StyleParam("Trigger Effect", EFFECT, nullptr)
+            StyleParam("Trigger Effect", EFFECT, nullptr)
             ),
         RUN() {}
         GETINT() {}
@@ -1037,7 +1155,7 @@ FUNC(EffectRandom, "Random On Effect",
 // NEED A BETTER HUMAN NAME
 FUNC(RandomBlinkF, "Random Per Interval",
         PARAMS(
-            new StyleParam("Time (mHz)", FUNCTION, get("Int")(PARAMVEC(1)))
+            StyleParam("Time (mHz)", FUNCTION, get("Int")(PARAMVEC(1)))
             ),
         RUN() {}
         GETINT() {}
@@ -1049,9 +1167,9 @@ FUNC(RandomBlinkF, "Random Per Interval",
 // return value: INTEGER
 FUNC(Scale, "Scale",
         PARAMS(
-            new StyleParam("Input", FUNCTION, nullptr),
-            new StyleParam("Min", FUNCTION, get("Int")(PARAMVEC(0))),
-            new StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768)))
+            StyleParam("Input", FUNCTION, nullptr),
+            StyleParam("Min", FUNCTION, get("Int")(PARAMVEC(0))),
+            StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768)))
             ),
         RUN() {}
         GETINT() {}
@@ -1064,7 +1182,7 @@ FUNC(Scale, "Scale",
 // is an example I suppose...
 FUNC(InvertF, "Invert",
         PARAMS(
-            new StyleParam("Input", FUNCTION, nullptr)
+            StyleParam("Input", FUNCTION, nullptr)
             ),
         RUN() {}
         GETINT() {}
@@ -1082,9 +1200,9 @@ FUNC(InvertF, "Invert",
 // SequenceF<100, 37, 0b0001010100011100, 0b0111000111000101, 0b0100000000000000>
 FUNC(SequenceF, "Binary Sequence",
         PARAMS(
-            new NumberParam("Time Per Bit (ms)", 100),
-            new NumberParam("Number of Bits", 16),
-            new BitsParam("Bit Section #", 0b1010101010101010, VARIADIC)
+            NumberParam("Time Per Bit (ms)", 100),
+            NumberParam("Number of Bits", 16),
+            BitsParam("Bit Section #", 0b1010101010101010, VARIADIC)
             ),
         RUN() {}
         GETINT() {}
@@ -1098,9 +1216,9 @@ FUNC(SequenceF, "Binary Sequence",
 // return value: INTEGER
 FUNC(Sin, "Sin",
         PARAMS(
-            new StyleParam("RPM", FUNCTION, get("Int")(PARAMVEC(60))),
-            new StyleParam("Min", FUNCTION, get("Int")(PARAMVEC(0))),
-            new StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768)))
+            StyleParam("RPM", FUNCTION, get("Int")(PARAMVEC(60))),
+            StyleParam("Min", FUNCTION, get("Int")(PARAMVEC(0))),
+            StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768)))
             ),
         RUN() {}
         GETINT() {}
@@ -1109,9 +1227,9 @@ FUNC(Sin, "Sin",
 // NO DOCUMENTATION
 FUNC(Saw, "Saw",
         PARAMS(
-            new StyleParam("RPM", FUNCTION, get("Int")(PARAMVEC(60))),
-            new StyleParam("Min", FUNCTION, get("Int")(PARAMVEC(0))),
-            new StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768)))
+            StyleParam("RPM", FUNCTION, get("Int")(PARAMVEC(60))),
+            StyleParam("Min", FUNCTION, get("Int")(PARAMVEC(0))),
+            StyleParam("Max", FUNCTION, get("Int")(PARAMVEC(32768)))
             ),
         RUN() {}
         GETINT() {}
@@ -1120,7 +1238,7 @@ FUNC(Saw, "Saw",
 // NO DOCUMENTATION
 FUNC(PulsingF, "Pulsing",
         PARAMS(
-            new StyleParam("Time (ms)", FUNCTION, get("Int")(PARAMVEC(100)))
+            StyleParam("Time (ms)", FUNCTION, get("Int")(PARAMVEC(100)))
             ),
         RUN() {}
         GETINT() {}
@@ -1142,8 +1260,8 @@ FUNC(PulsingF, "Pulsing",
 // NEED TO ADD DENSITY FUNCTIONS
 FUNC(SliceF, "Slice",
         PARAMS(
-            new StyleParam("Density Function", FUNCTION3D, nullptr),
-            new NumberParam("Offset", 20)
+            StyleParam("Density Function", FUNCTION3D, nullptr),
+            NumberParam("Offset", 20)
             ),
         RUN() {}
         GETINT() {}
@@ -1160,8 +1278,8 @@ FUNC(SliceF, "Slice",
 // the blade. If WIDTH is negative, the transition will go the other way.
 FUNC(SmoothStep, "Smooth Step",
         PARAMS(
-            new StyleParam("Position", FUNCTION, get("Int")(PARAMVEC(16384))),
-            new StyleParam("Width", FUNCTION, get("Int")(PARAMVEC(16384))),
+            StyleParam("Position", FUNCTION, get("Int")(PARAMVEC(16384))),
+            StyleParam("Width", FUNCTION, get("Int")(PARAMVEC(16384))),
             ),
         RUN() {}
         GETINT() {}
@@ -1169,19 +1287,22 @@ FUNC(SmoothStep, "Smooth Step",
 
 FUNC3D(SmokeDF, "Smoke",
         PARAMS(),
-        RUN() {}
+        RUN3D() {}
         GETINT3D() {}
       )
 
 FUNC3D(FastSmokeDF, "Fast Smoke",
         PARAMS(),
-        RUN() {}
+        RUN3D() {}
         GETINT3D() {}
       )
 
 const StyleMap FunctionStyle::map {
+    STYLEPAIR(BatteryLevel),
     STYLEPAIR(BlinkingF),
-    STYLEPAIR(Int)
+    STYLEPAIR(Bump),
+    STYLEPAIR(Int),
+    STYLEPAIR(OriginalBlastF),
 };
 
 const StyleMap Function3DStyle::map {
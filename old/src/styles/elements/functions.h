@@ -20,9 +20,12 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <span>
+
 #include "stylepreview/blade.h"
 #include "proffieconstructs/vector3d.h"
 #include "styles/bladestyle.h"
+#include "styles/variance.h"
 
 namespace BladeStyles {
 
@@ -44,6 +47,9 @@ namespace BladeStyles {
  * bladestyle, it takes in an led index and returns the appropriate value.
  * (It's worth noting that I'm referencing what ProffieOS calls "function" bladestyles and C++
  * functions back and forth here, and they're *NOT* the same thing) 
+ *
+ * Here an SVF is just a function which reports Variance::PER_FRAME, which lets the bytecode
+ * compiler call it once per frame instead of once per LED.
  */
 class FunctionStyle : public BladeStyle {
 public:
@@ -55,15 +61,64 @@ public:
      *  Used to get the value for each LED
      */
     virtual int32_t getInt(int32_t) = 0;
+    /**
+     * Fill out with the values for LEDs [ledBegin, ledBegin + out.size())
+     *
+     * The default calls getInt() for each LED, override where a whole
+     * run can be computed more cheaply.
+     */
+    virtual void getInts(std::span<int32_t> out, int32_t ledBegin = 0);
+    /**
+     * How often this function's own value changes.
+     *
+     * PER_FRAME functions (SVFs) only sample their params at LED 0, so they
+     * stay PER_FRAME whatever their params are. CONSTANT functions take on
+     * the variance of their params.
+     */
+    [[nodiscard]] virtual Variance getVariance() const;
+
+    /**
+     * Have run() do nothing and getInt()/getInts() read back values, for
+     * the bytecode interpreter, which works them out before whatever uses
+     * this function runs. A single value is used for every LED.
+     *
+     * Bind an empty span to go back to evaluating normally.
+     */
+    void bindValues(std::span<const int32_t> values) { mBoundValues = values; }
+    [[nodiscard]] std::span<const int32_t> getBoundValues() const { return mBoundValues; }
+    [[nodiscard]] bool isBound() const { return !mBoundValues.empty(); }
 
     static StyleGenerator get(const std::string& styleName);
     static const StyleMap& getMap();
 
 protected:
-    FunctionStyle(const char* osName, const char* humanName, const std::vector<Param*>&, StyleType typeOverride = 0);
+    FunctionStyle(const char* osName, const char* humanName, const std::vector<Param>&, StyleType typeOverride = 0);
+
+    /**
+     * LEDs past either end of the bound values read the nearest one.
+     */
+    [[nodiscard]] int32_t getBoundInt(int32_t led) const;
+    void getBoundInts(std::span<int32_t> out, int32_t ledBegin) const;
 
 private:
     static const StyleMap map;
+
+    std::span<const int32_t> mBoundValues;
+};
+
+/**
+ * The per-frame state of Bump<>, kept separate so the bytecode
+ * interpreter can evaluate a bump without going through the element.
+ */
+struct BumpShape {
+    BumpShape() = default;
+    BumpShape(int32_t position, int32_t width, int32_t numLeds);
+
+    [[nodiscard]] int32_t getInt(int32_t led) const;
+    void getInts(std::span<int32_t> out, int32_t ledBegin) const;
+
+    int32_t location{-10000};
+    int32_t multiplier{1};
 };
 
 /*
@@ -91,7 +146,7 @@ public:
     static const StyleMap& getMap();
 
 protected:
-    Function3DStyle(const char* osName, const char* humanName, const std::vector<Param*>&);
+    Function3DStyle(const char* osName, const char* humanName, const std::vector<Param>&);
 
 private:
     static const StyleMap map;
@@ -24,7 +24,7 @@
 
 using namespace BladeStyles;
 
-LayerStyle::LayerStyle(const char* osName, const char* humanName, const std::vector<Param*>& params) :
+LayerStyle::LayerStyle(const char* osName, const char* humanName, const std::vector<Param>& params) :
     ColorStyle(osName, humanName, params, BladeStyles::LAYER) {}
 
 StyleGenerator LayerStyle::get(const std::string& styleName) {
@@ -38,6 +38,12 @@ StyleType LayerStyle::getType() const { return pType; }
 
 const StyleMap& LayerStyle::getMap() { return map; }
 
+void LayerStyle::render(LedFrame& out) {
+    mLayerFrame.resize(out.size());
+    ColorStyle::render(mLayerFrame);
+    out.paintOver(mLayerFrame);
+}
+
 #define RUN(varname) virtual void run(const StylePreview::Blade& varname) override
 #define GETINT(varname) virtual uint16_t getInt(uint32_t varname) override
 #define GETINT3D(varname) virtual uint16_t getInt(const StylePreview::Vector3D& varname) override
@@ -30,14 +30,21 @@ public:
 
      [[nodiscard]] StyleType getType() const override;
 
+    /**
+     * Renders the layer into its own frame and paints that over out.
+     */
+    void render(LedFrame& out) override;
+
     static StyleGenerator get(const std::string& styleName);
     static const StyleMap& getMap();
 
 protected:
-    LayerStyle(const char* osName, const char* humanName, const std::vector<Param*>& params);
+    LayerStyle(const char* osName, const char* humanName, const std::vector<Param>& params);
 
 private:
     static const StyleMap map;
+
+    LedFrame mLayerFrame;
 };
 
 } // namespace BladeStyles
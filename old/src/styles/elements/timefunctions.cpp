@@ -26,7 +26,7 @@
 
 using namespace BladeStyles;
 
-TimeFunctionStyle::TimeFunctionStyle(const char* osName, const char* humanName, const std::vector<Param*>& params) :
+TimeFunctionStyle::TimeFunctionStyle(const char* osName, const char* humanName, const std::vector<Param>& params) :
     FunctionStyle(osName, humanName, params, TIMEFUNC) {}
 
 const StyleMap& TimeFunctionStyle::getMap() { return map; }
@@ -59,7 +59,7 @@ public:
     TimeFunctionStyleW(
             const char* osName, 
             const char* humanName, 
-            const std::vector<Param*>& params) :
+            const std::vector<Param>& params) :
         TimeFunctionStyle(osName, humanName, params), pBase() {}
 
     double bend(uint32_t time, uint32_t length, double scale) override { return pBase.bend(time, length, scale); }
@@ -79,8 +79,8 @@ protected:
 
 TIMEFUNC(BendTimePowX, "Exponential Time Bend",
         PARAMS(
-            new StyleParam("Time (ms)", FUNCTION | TIMEFUNC, FunctionStyle::get("Int")(PARAMVEC(1000))),
-            new StyleParam("Power", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(65536)))
+            StyleParam("Time (ms)", FUNCTION | TIMEFUNC, FunctionStyle::get("Int")(PARAMVEC(1000))),
+            StyleParam("Power", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(65536)))
             ),
         RUN(blade) {
             auto timeParam{getParamStyle(0)};
@@ -88,9 +88,9 @@ TIMEFUNC(BendTimePowX, "Exponential Time Bend",
                 if (!dynamic_cast<AddBend*>(millisStyle)) {
                     millisStyle = new AddBend();
                 }
-                millisStyle->setParam(0, const_cast<BladeStyle*>(timeParam));
+                millisStyle->setParam(0, borrow(timeParam));
             } else {
-                delete millisStyle;
+                if (dynamic_cast<AddBend*>(millisStyle)) release(millisStyle);
                 millisStyle = const_cast<TimeFunctionStyle*>(static_cast<const TimeFunctionStyle*>(timeParam));
             }
 
@@ -109,7 +109,7 @@ TIMEFUNC(BendTimePowX, "Exponential Time Bend",
 
         ~BendTimePowX() { 
             if (dynamic_cast<AddBend*>(millisStyle)) {
-                delete millisStyle;
+                release(millisStyle);
             }
         }
 
@@ -122,7 +122,7 @@ TIMEFUNC(BendTimePowX, "Exponential Time Bend",
 
 TIMEFUNC(ReverseTimeX, "Reverse Time",
         PARAMS(
-            new StyleParam("Time (ms)", FUNCTION | TIMEFUNC, FunctionStyle::get("Int")(PARAMVEC(1000)))
+            StyleParam("Time (ms)", FUNCTION | TIMEFUNC, FunctionStyle::get("Int")(PARAMVEC(1000)))
             ),
         RUN(blade) {
             auto timeParam{getParamStyle(0)};
@@ -130,9 +130,9 @@ TIMEFUNC(ReverseTimeX, "Reverse Time",
                 if (!dynamic_cast<AddBend*>(millisStyle)) {
                     millisStyle = new AddBend();
                 }
-                millisStyle->setParam(0, const_cast<BladeStyle*>(timeParam));
+                millisStyle->setParam(0, borrow(timeParam));
             } else {
-                delete millisStyle;
+                if (dynamic_cast<AddBend*>(millisStyle)) release(millisStyle);
                 millisStyle = const_cast<TimeFunctionStyle*>(static_cast<const TimeFunctionStyle*>(timeParam));
             }
 
@@ -151,16 +151,16 @@ TIMEFUNC(ReverseTimeX, "Reverse Time",
 
 TIMEFUNCW(BendTimePowInvX, "Inverse Exponential Time Bend", ReverseTimeX,
         PARAMS(
-            new StyleParam("Time (ms)", FUNCTION | TIMEFUNC, FunctionStyle::get("Int")(PARAMVEC(1000))),
-            new StyleParam("Power", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(65536)))
+            StyleParam("Time (ms)", FUNCTION | TIMEFUNC, FunctionStyle::get("Int")(PARAMVEC(1000))),
+            StyleParam("Power", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(65536)))
             ),
         RUN(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, TimeFunctionStyle::get("BendTimePowX")(PARAMVEC()));
             auto timeBendStyle{STYLECAST(TimeFunctionStyle, pBase.getParamStyle(0))};
 
             if (timeBendStyle->getParamStyle(0)) timeBendStyle->setParam(0, TimeFunctionStyle::get("ReverseTimeX")(PARAMVEC()));
-            const_cast<BladeStyle*>(timeBendStyle->getParamStyle(0))->setParam(0, const_cast<BladeStyle*>(getParamStyle(0)));
-            timeBendStyle->setParam(1, const_cast<BladeStyle*>(getParamStyle(1)));
+            const_cast<BladeStyle*>(timeBendStyle->getParamStyle(0))->setParam(0, borrow(getParamStyle(0)));
+            timeBendStyle->setParam(1, borrow(getParamStyle(1)));
             
             pBase.run(blade);
         }
@@ -168,8 +168,8 @@ TIMEFUNCW(BendTimePowInvX, "Inverse Exponential Time Bend", ReverseTimeX,
 
 TIMEFUNCW(BendTimePow, "Inverse Time Bend", BendTimePowX,
         PARAMS(
-            new NumberParam("Millis", 1000),
-            new NumberParam("Power", 65536)
+            NumberParam("Millis", 1000),
+            NumberParam("Power", 65536)
             ),
         RUN(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, FunctionStyle::get("Int")(PARAMVEC()));
@@ -184,8 +184,8 @@ TIMEFUNCW(BendTimePow, "Inverse Time Bend", BendTimePowX,
 
 TIMEFUNCW(BendTimePowInv, "Inverse Exponential Time Bend", BendTimePowInvX,
         PARAMS(
-            new NumberParam("Millis", 1000),
-            new NumberParam("Power", 65536)
+            NumberParam("Millis", 1000),
+            NumberParam("Power", 65536)
             ),
         RUN(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, FunctionStyle::get("Int")(PARAMVEC()));
@@ -200,7 +200,7 @@ TIMEFUNCW(BendTimePowInv, "Inverse Exponential Time Bend", BendTimePowInvX,
 
 TIMEFUNCW(ReverseTime, "Reverse Time", ReverseTimeX,
         PARAMS(
-            new NumberParam("Millis", 1000)
+            NumberParam("Millis", 1000)
             ),
         RUN(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, FunctionStyle::get("Int")(PARAMVEC()));
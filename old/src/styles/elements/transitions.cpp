@@ -18,13 +18,16 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <array>
+
 #include "proffieconstructs/range.h"
 #include "proffieconstructs/utilfuncs.h"
+#include "stylepreview/profiler.h"
 #include "styles/bladestyle.h"
 #include "styles/elements/colorstyles.h"
 #include "styles/elements/functions.h"
 #include "styles/elements/timefunctions.h"
-#include "utility/time.h"
 
 using namespace BladeStyles;
 
@@ -38,14 +41,14 @@ static constexpr std::array<uint8_t, 32> BLAST_HUMP{
 TransitionStyle::TransitionStyle(
         const char* osName, 
         const char* humanName, 
-        const std::vector<Param*>& params) :
+        const std::vector<Param>& params) :
     BladeStyle(osName, humanName, TRANSITION, params) {}
 
 class TransitionStyleImpl : public TransitionStyle {
 public:
     ~TransitionStyleImpl() override {
         if (dynamic_cast<AddBend*>(mMillisFunc)) {
-            delete mMillisFunc;
+            release(mMillisFunc);
         }
     }
 
@@ -62,7 +65,7 @@ public:
     [[nodiscard]] uint32_t getStartMillis() const override;
 
 protected:
-    TransitionStyleImpl(const char* osName, const char* humanName, const std::vector<Param*>& params, const int32_t millisIndex) :
+    TransitionStyleImpl(const char* osName, const char* humanName, const std::vector<Param>& params, const int32_t millisIndex) :
         TransitionStyle(osName, humanName, params), mMillisIndex(millisIndex) {}
 
     /**
@@ -79,6 +82,11 @@ protected:
     // use a double. Ugliness ensues.
     double update(double scale);
 
+    /**
+     * Blade time as of the current frame's run()
+     */
+    [[nodiscard]] uint64_t getNowMillis() const { return mNowMillis; }
+
 private:
     bool mRestart{false};
 
@@ -91,6 +99,7 @@ private:
 
     uint32_t mStartMillis{0};
     uint32_t mLength{0};
+    uint64_t mNowMillis{0};
 };
 
 // Logic stays in the base, and we can (relatively) easily map the parameters
@@ -98,7 +107,7 @@ private:
 template<class T>
 class TransitionStyleWrap : public TransitionStyle {
 public:
-    TransitionStyleWrap(const char* osName, const char* humanName, const std::vector<Param*>& params) :
+    TransitionStyleWrap(const char* osName, const char* humanName, const std::vector<Param>& params) :
         TransitionStyle(osName, humanName, params), pBase() {}
 
     void begin() override { return pBase.begin(); }
@@ -108,6 +117,12 @@ public:
     ColorData getColor(const ColorData& colorA, const ColorData& colorB, int32_t led) override {
         return pBase.getColor(colorA, colorB, led);
     }
+    void getColors(std::span<const ColorData> colorsA, std::span<const ColorData> colorsB, std::span<ColorData> out, int32_t ledBegin) override {
+        pBase.getColors(colorsA, colorsB, out, ledBegin);
+    }
+    void render(const LedFrame& frameA, const LedFrame& frameB, LedFrame& out) override {
+        pBase.render(frameA, frameB, out);
+    }
 
 protected:
     T pBase;
@@ -115,11 +130,15 @@ protected:
 
 
 void TransitionStyleImpl::run(StylePreview::Blade& blade) {
+    PROFILE_STYLE("run");
+
     // This type comparison, although it is evaluated at runtime,
     // will always be the same, because the param types are permanent
     // for the object's life, and are also basically baked into the 
     // specific class.
 
+    mNowMillis = blade.getTimeMS();
+
     if (mMillisIndex == -1) {
         doRun(blade);
         return;
@@ -130,16 +149,16 @@ void TransitionStyleImpl::run(StylePreview::Blade& blade) {
 
     // This could change based on given parameter.
     if (timeParam->getType() & TIMEFUNC) {
-        if (dynamic_cast<AddBend*>(mMillisFunc)) delete mMillisFunc;
+        if (dynamic_cast<AddBend*>(mMillisFunc)) release(mMillisFunc);
         mMillisFunc = const_cast<TimeFunctionStyle*>(static_cast<const TimeFunctionStyle*>(timeParam));
     } else { // If type is FUNCTION
         if (!dynamic_cast<AddBend*>(mMillisFunc)) mMillisFunc = new AddBend();
-        mMillisFunc->setParam(0, const_cast<BladeStyle*>(timeParam));
+        mMillisFunc->setParam(0, borrow(timeParam));
     }
 
     mMillisFunc->run(blade);
     if (mRestart) {
-        mStartMillis = Utility::getTimeMS();
+        mStartMillis = mNowMillis;
         mLength = mMillisFunc->getInt(0);
         mRestart = false;
     }
@@ -148,7 +167,7 @@ void TransitionStyleImpl::run(StylePreview::Blade& blade) {
 }
 double TransitionStyleImpl::update(double scale) {
     if (isDone()) return scale;
-    auto timeDelta{Utility::getTimeMS() - mStartMillis};
+    auto timeDelta{mNowMillis - mStartMillis};
 
     if (timeDelta > mLength) {
         mLength = 0;
@@ -171,6 +190,31 @@ bool TransitionStyleImpl::shouldRestart() const { return mRestart; }
 
 uint32_t TransitionStyleImpl::getStartMillis() const { return mStartMillis; }
 
+void TransitionStyle::getColors(std::span<const ColorData> colorsA, std::span<const ColorData> colorsB, std::span<ColorData> out, int32_t ledBegin) {
+    for (size_t idx{0}; idx < out.size(); idx++) {
+        out[idx] = getColor(colorsA[idx], colorsB[idx], ledBegin + static_cast<int32_t>(idx));
+    }
+}
+
+void TransitionStyle::render(const LedFrame& frameA, const LedFrame& frameB, LedFrame& out) {
+    PROFILE_STYLE("render");
+    constexpr int32_t CHUNK_SIZE{32};
+    std::array<ColorData, CHUNK_SIZE> chunkA;
+    std::array<ColorData, CHUNK_SIZE> chunkB;
+    for (int32_t ledBegin{0}; ledBegin < out.size(); ledBegin += CHUNK_SIZE) {
+        const auto chunkSize{static_cast<size_t>(std::min(CHUNK_SIZE, out.size() - ledBegin))};
+        const auto colorsA{std::span{chunkA}.first(chunkSize)};
+        const auto colorsB{std::span{chunkB}.first(chunkSize)};
+        for (size_t idx{0}; idx < chunkSize; idx++) {
+            const auto led{ledBegin + static_cast<int32_t>(idx)};
+            colorsA[idx] = frameA.getColor(led);
+            colorsB[idx] = frameB.getColor(led);
+        }
+        getColors(colorsA, colorsB, colorsA, ledBegin);
+        out.setColors(colorsA, ledBegin);
+    }
+}
+
 StyleGenerator TransitionStyle::get(const std::string& styleName) {
     const auto& map{getMap()};
     const auto& mapIt{map.find(styleName)};
@@ -183,9 +227,25 @@ const StyleMap& TransitionStyle::getMap() { return map; }
 #define RUN(varname) \
     void doRun(StylePreview::Blade& varname) override
 
+// Called per LED, so not profiled
 #define GETCOLOR(colorAvarname, colorBvarname, ledvarname) \
     ColorData getColor(const ColorData& colorAvarname, const ColorData& colorBvarname, int32_t ledvarname) override
 
+// The element's body goes in the *Impl function, so every call can be profiled
+#define GETCOLORS(colorsAvarname, colorsBvarname, outvarname, beginvarname) \
+    void getColors(std::span<const ColorData> colorsA, std::span<const ColorData> colorsB, std::span<ColorData> out, int32_t ledBegin) override { \
+        PROFILE_STYLE("getColors"); \
+        getColorsImpl(colorsA, colorsB, out, ledBegin); \
+    } \
+    void getColorsImpl(std::span<const ColorData> colorsAvarname, std::span<const ColorData> colorsBvarname, std::span<ColorData> outvarname, int32_t beginvarname)
+
+#define RENDER(frameAvarname, frameBvarname, outvarname) \
+    void render(const LedFrame& frameA, const LedFrame& frameB, LedFrame& out) override { \
+        PROFILE_STYLE("render"); \
+        renderImpl(frameA, frameB, out); \
+    } \
+    void renderImpl(const LedFrame& frameAvarname, const LedFrame& frameBvarname, LedFrame& outvarname)
+
 #define TRANS(osName, humanName, millisIndex, params, ...) \
     class osName : public TransitionStyleImpl { \
     public: \
@@ -194,7 +254,8 @@ const StyleMap& TransitionStyle::getMap() { return map; }
     }; 
 
 #define RUNW(varname) \
-    virtual void run(StylePreview::Blade& varname) override
+    virtual void run(StylePreview::Blade& blade) override { PROFILE_STYLE("run"); runImpl(blade); } \
+    void runImpl(StylePreview::Blade& varname)
 
 #define TRANSW(osName, humanName, base, params, ...) \
     class osName : public TransitionStyleWrap<base> { \
@@ -211,9 +272,9 @@ const StyleMap& TransitionStyle::getMap() { return map; }
 // chain transitions like ((A TR1 B) TR2 B)
 TRANS(TrJoin, "Join", -1,
         PARAMS(
-            new StyleParam("Transition 1", TRANSITION, nullptr),
-            new StyleParam("Transition 2", TRANSITION, nullptr),
-            new StyleParam("Transition #", TRANSITION | VARIADIC, nullptr)
+            StyleParam("Transition 1", TRANSITION, nullptr),
+            StyleParam("Transition 2", TRANSITION, nullptr),
+            StyleParam("Transition #", TRANSITION | VARIADIC, nullptr)
             ),
 
         RUN(blade) {
@@ -237,6 +298,12 @@ TRANS(TrJoin, "Join", -1,
 
             return res;
         }
+        GETCOLORS(colorsA, colorsB, out, ledBegin) {
+            transitions.front()->getColors(colorsA, colorsB, out, ledBegin);
+            for (auto it{std::next(transitions.begin())}; it != transitions.end(); it++) {
+                (*it)->getColors(out, colorsB, out, ledBegin);
+            }
+        }
 
         virtual void begin() override {
             for (auto transition : transitions) transition->begin();
@@ -259,9 +326,9 @@ TRANS(TrJoin, "Join", -1,
 // (A TR2 (A TR1 B))
 TRANS(TrJoinR, "Reverse Join", -1,
         PARAMS(
-            new StyleParam("Transition 1", TRANSITION, nullptr),
-            new StyleParam("Transition 2", TRANSITION, nullptr),
-            new StyleParam("Transition #", TRANSITION | VARIADIC, nullptr)
+            StyleParam("Transition 1", TRANSITION, nullptr),
+            StyleParam("Transition 2", TRANSITION, nullptr),
+            StyleParam("Transition #", TRANSITION | VARIADIC, nullptr)
             ),
 
         RUN(blade) {
@@ -285,6 +352,12 @@ TRANS(TrJoinR, "Reverse Join", -1,
 
             return res;
         }
+        GETCOLORS(colorsA, colorsB, out, ledBegin) {
+            transitions.front()->getColors(colorsA, colorsB, out, ledBegin);
+            for (auto it{std::next(transitions.begin())}; it != transitions.end(); it++) {
+                (*it)->getColors(colorsA, out, out, ledBegin);
+            }
+        }
 
         virtual void run(StylePreview::Blade& blade) override { doRun(blade); }
         virtual void begin() override {
@@ -312,9 +385,9 @@ TRANS(TrJoinR, "Reverse Join", -1,
 // If WIDTH = 16384 A and B appear equally, lower decreases length of A, higher increases length of A
 TRANS(TrBlinkX, "Blink", 0,
         PARAMS(
-            new StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
-            new NumberParam("Number of Blinks"),
-            new StyleParam("Distribution", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(16384)))
+            StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
+            NumberParam("Number of Blinks"),
+            StyleParam("Distribution", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(16384)))
             ),
         RUN(blade) {
             auto distStyle{const_cast<FunctionStyle*>(static_cast<const FunctionStyle*>(getParamStyle(2)))};
@@ -333,9 +406,9 @@ TRANS(TrBlinkX, "Blink", 0,
 
 TRANSW(TrBlink, "Blink", TrBlinkX,
         PARAMS(
-            new NumberParam("Time (ms)"),
-            new NumberParam("Number of Blinks"),
-            new NumberParam("Distribution", 16384)
+            NumberParam("Time (ms)"),
+            NumberParam("Number of Blinks"),
+            NumberParam("Distribution", 16384)
             ),
         RUNW(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, FunctionStyle::get("Int")(PARAMVEC()));
@@ -363,8 +436,8 @@ TRANSW(TrBlink, "Blink", TrBlinkX,
 // and so on.
 TRANS(TrBoingX, "Boing", 0,
         PARAMS(
-            new StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
-            new NumberParam("Number of Boings")
+            StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
+            NumberParam("Number of Boings")
             ),
         RUN() {
             fadeAmount = update(16348 * ((getParamNumber(1) * 2) + 1));
@@ -383,8 +456,8 @@ TRANS(TrBoingX, "Boing", 0,
 
 TRANSW(TrBoing, "Boing", TrBoingX,
         PARAMS(
-            new NumberParam("Time (ms)"),
-            new NumberParam("Number of Boings")
+            NumberParam("Time (ms)"),
+            NumberParam("Number of Boings")
             ),
         RUNW(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, FunctionStyle::get("Int")(PARAMVEC()));
@@ -407,8 +480,8 @@ TRANSW(TrBoing, "Boing", TrBoingX,
 // in the specified number of milliseconds.
 TRANS(TrCenterWipeX, "Center Wipe", 0,
     PARAMS(
-        new StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
-        new StyleParam("Center Position", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(16384)))
+        StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
+        StyleParam("Center Position", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(16384)))
         ),
     RUN(blade) {
         auto posFunc{const_cast<FunctionStyle*>(static_cast<const FunctionStyle*>(getParamStyle(1)))};
@@ -432,8 +505,8 @@ TRANS(TrCenterWipeX, "Center Wipe", 0,
 
 TRANSW(TrCenterWipe, "Center Wipe", TrCenterWipeX,
         PARAMS(
-            new NumberParam("Time (ms)"),
-            new NumberParam("Center Position", 16384)
+            NumberParam("Time (ms)"),
+            NumberParam("Center Position", 16384)
             ),
         RUNW(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, FunctionStyle::get("Int")(PARAMVEC()));
@@ -460,24 +533,24 @@ TRANSW(TrCenterWipe, "Center Wipe", TrCenterWipeX,
 //                      >;
 TRANSW(TrCenterWipeSparkX, "Center Wipe With Spark", TrJoin,
         PARAMS(
-            new StyleParam("Spark Color", COLOR, nullptr), 
-            new StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
-            new StyleParam("Center Position", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(16384)))
+            StyleParam("Spark Color", COLOR, nullptr), 
+            StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
+            StyleParam("Center Position", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(16384)))
             ),
         RUNW(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, TransitionStyle::get("TrCenterWipeX")(PARAMVEC()));
             auto centerWipeTransition{const_cast<TransitionStyle*>(static_cast<const TransitionStyle*>(pBase.getParamStyle(0)))};
 
-            centerWipeTransition->setParam(0, const_cast<BladeStyle*>(getParamStyle(1)));
-            centerWipeTransition->setParam(1, const_cast<BladeStyle*>(getParamStyle(2)));
+            centerWipeTransition->setParam(0, borrow(getParamStyle(1)));
+            centerWipeTransition->setParam(1, borrow(getParamStyle(2)));
 
             if (!pBase.getParamStyle(1)) pBase.setParam(1, TransitionStyle::get("TrWaveX")(PARAMVEC()));
             auto waveTransition{const_cast<TransitionStyle*>(static_cast<const TransitionStyle*>(pBase.getParamStyle(1)))};
 
-            waveTransition->setParam(0, const_cast<BladeStyle*>(getParamStyle(0)));
+            waveTransition->setParam(0, borrow(getParamStyle(0)));
 
             if (!waveTransition->getParamStyle(1)) waveTransition->setParam(1, FunctionStyle::get("Sum")(PARAMVEC()));
-            auto timeFunc{const_cast<BladeStyle*>(getParamStyle(1))};
+            const auto timeFunc{borrow(getParamStyle(1))};
             const_cast<BladeStyle*>(waveTransition->getParamStyle(1))->setParams(PARAMVEC(timeFunc, timeFunc, timeFunc, timeFunc));
 
             if (!waveTransition->getParamStyle(2)) waveTransition->setParam(2, FunctionStyle::get("Int")(PARAMVEC(200)));
@@ -485,7 +558,7 @@ TRANSW(TrCenterWipeSparkX, "Center Wipe With Spark", TrJoin,
             if (!waveTransition->getParamStyle(3)) waveTransition->setParam(3, FunctionStyle::get("Sum")(PARAMVEC()));
             const_cast<BladeStyle*>(waveTransition->getParamStyle(3))->setParams(PARAMVEC(timeFunc, timeFunc));
 
-            waveTransition->setParam(4, const_cast<BladeStyle*>(getParamStyle(2)));
+            waveTransition->setParam(4, borrow(getParamStyle(2)));
 
             pBase.run(blade);
         }
@@ -493,12 +566,12 @@ TRANSW(TrCenterWipeSparkX, "Center Wipe With Spark", TrJoin,
 
 TRANSW(TrCenterWipeSpark, "Center Wipe With Spark", TrCenterWipeSparkX,
         PARAMS(
-            new StyleParam("Spark Color", COLOR, nullptr), 
-            new NumberParam("Time (ms)"),
-            new NumberParam("Center Position", 16384),
+            StyleParam("Spark Color", COLOR, nullptr), 
+            NumberParam("Time (ms)"),
+            NumberParam("Center Position", 16384),
             ),
         RUNW(blade) {
-            pBase.setParam(0, const_cast<BladeStyle*>(getParamStyle(0)));
+            pBase.setParam(0, borrow(getParamStyle(0)));
 
             if (!pBase.getParamStyle(1)) pBase.setParam(1, FunctionStyle::get("Int")(PARAMVEC()));
             const_cast<BladeStyle*>(pBase.getParamStyle(1))->setParam(0, getParamNumber(1));
@@ -521,8 +594,8 @@ TRANSW(TrCenterWipeSpark, "Center Wipe With Spark", TrCenterWipeSparkX,
 // in the specified number of milliseconds.
 TRANS(TrCenterWipeInX, "Center Wipe In", 0,
         PARAMS(
-            new StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
-            new StyleParam("Center Position", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(16384))),
+            StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
+            StyleParam("Center Position", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(16384))),
             ),
         RUN(blade) {
             auto posFunc{const_cast<FunctionStyle*>(static_cast<const FunctionStyle*>(getParamStyle(1)))};
@@ -546,8 +619,8 @@ TRANS(TrCenterWipeInX, "Center Wipe In", 0,
 
  TRANSW(TrCenterWipeIn, "Center Wipe In", TrCenterWipeInX,
          PARAMS(
-             new NumberParam("Time (ms)"),
-             new NumberParam("Center Position", 16384)
+             NumberParam("Time (ms)"),
+             NumberParam("Center Position", 16384)
              ),
          RUNW(blade) {
          if (!pBase.getParamStyle(0)) pBase.setParam(0, FunctionStyle::get("Int")(PARAMVEC()));
@@ -581,17 +654,17 @@ TRANS(TrCenterWipeInX, "Center Wipe In", 0,
 //                          >
 TRANSW(TrCenterWipeInSparkX, "Center Wipe In With Spark", TrJoin,
      PARAMS(
-         new StyleParam("Spark Color", COLOR, nullptr), 
-         new StyleParam("Time (ms)", TIMEFUNC | FUNCTION, nullptr),
-         new StyleParam("Center Position", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(16384)))
+         StyleParam("Spark Color", COLOR, nullptr), 
+         StyleParam("Time (ms)", TIMEFUNC | FUNCTION, nullptr),
+         StyleParam("Center Position", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(16384)))
          ),
      RUNW(blade) {
         if (!pBase.getParamStyle(0)) pBase.setParam(0, TransitionStyle::get("TrCenterWipeInX")(PARAMVEC()));
         auto centerWipeTransition{STYLECAST(TransitionStyle, pBase.getParamStyle(0))};
-        centerWipeTransition->setParam(0, const_cast<BladeStyle*>(getParamStyle(1)));
-        centerWipeTransition->setParam(1, const_cast<BladeStyle*>(getParamStyle(2)));
+        centerWipeTransition->setParam(0, borrow(getParamStyle(1)));
+        centerWipeTransition->setParam(1, borrow(getParamStyle(2)));
 
-        auto millisFunc{const_cast<BladeStyle*>(getParamStyle(1))};
+        const auto millisFunc{borrow(getParamStyle(1))};
         if (!pBase.getParamStyle(1)) pBase.setParam(1, TransitionStyle::get("TrJoin")(PARAMVEC()));
         auto joinTransition{STYLECAST(TransitionStyle, pBase.getParamStyle(1))};
 
@@ -609,13 +682,13 @@ TRANSW(TrCenterWipeInSparkX, "Center Wipe In With Spark", TrJoin,
         if (!waveTr1->getParamStyle(4)) waveTr1->setParam(4, FunctionStyle::get("Int")(PARAMVEC(0)));
         if (!waveTr2->getParamStyle(4)) waveTr2->setParam(4, FunctionStyle::get("Int")(PARAMVEC(32768)));
 
-        waveTr1->setParam(0, const_cast<BladeStyle*>(getParamStyle(0)));
-        waveTr1->setParam(1, const_cast<BladeStyle*>(getParamStyle(1)));
+        waveTr1->setParam(0, borrow(getParamStyle(0)));
+        waveTr1->setParam(1, borrow(getParamStyle(1)));
         auto wave1Sum{STYLECAST(FunctionStyle, waveTr1->getParamStyle(3))};
         wave1Sum->setParams(PARAMVEC(millisFunc, millisFunc));
 
-        waveTr2->setParam(0, const_cast<BladeStyle*>(getParamStyle(0)));
-        waveTr2->setParam(1, const_cast<BladeStyle*>(getParamStyle(1)));
+        waveTr2->setParam(0, borrow(getParamStyle(0)));
+        waveTr2->setParam(1, borrow(getParamStyle(1)));
         auto wave2Sum{STYLECAST(FunctionStyle, waveTr2->getParamStyle(3))};
         wave2Sum->setParams(PARAMVEC(millisFunc, millisFunc));
 
@@ -625,12 +698,12 @@ TRANSW(TrCenterWipeInSparkX, "Center Wipe In With Spark", TrJoin,
 
 TRANSW(TrCenterWipeInSpark, "Center Wipe In With Spark", TrCenterWipeInSparkX,
         PARAMS(
-            new StyleParam("Spark Color", COLOR, nullptr), 
-            new NumberParam("Time (ms)"),
-            new NumberParam("Center Position", 16384)
+            StyleParam("Spark Color", COLOR, nullptr), 
+            NumberParam("Time (ms)"),
+            NumberParam("Center Position", 16384)
             ),
         RUNW(blade) {
-            pBase.setParam(0, const_cast<BladeStyle*>(getParamStyle(0)));
+            pBase.setParam(0, borrow(getParamStyle(0)));
 
             if (!pBase.getParamStyle(1)) pBase.setParam(1, FunctionStyle::get("Int")(PARAMVEC()));
             const_cast<BladeStyle*>(pBase.getParamStyle(1))->setParam(0, getParamNumber(1));
@@ -652,12 +725,12 @@ TRANSW(TrCenterWipeInSpark, "Center Wipe In With Spark", TrCenterWipeInSparkX,
 // immediately very erratic then stabilizes.
 TRANS(TrColorCycleX, "Color Cycle", 0,
         PARAMS(
-            new StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
-            new NumberParam("Start RPM", 0), 
-            new NumberParam("End RPM", 6000),
+            StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
+            NumberParam("Start RPM", 0), 
+            NumberParam("End RPM", 6000),
             ),
         RUN(blade) {
-            auto now{static_cast<uint32_t>(Utility::getTimeMicros())};
+            auto now{static_cast<uint32_t>(blade.getTimeMicros())};
             auto delta{now - lastMicros};
             lastMicros = now;
             if (delta > 1000000) delta = 1;
@@ -706,9 +779,9 @@ TRANS(TrColorCycleX, "Color Cycle", 0,
 
 TRANSW(TrColorCycle, "Color Cycle", TrColorCycleX,
         PARAMS(
-            new NumberParam("Time (ms)", 1000),
-            new NumberParam("Start RPM", 0), 
-            new NumberParam("End RPM", 6000),
+            NumberParam("Time (ms)", 1000),
+            NumberParam("Start RPM", 0), 
+            NumberParam("End RPM", 6000),
             ),
         RUNW(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, FunctionStyle::get("Int")(PARAMVEC()));
@@ -737,8 +810,8 @@ TRANSW(TrColorCycle, "Color Cycle", TrColorCycleX,
 // transition will then run backwards.
 TRANS(TrConcat, "Concatenate", -1,
         PARAMS(
-            new StyleParam("Transition 1", TRANSITION, nullptr),
-            new StyleParam("Transition or Color #", COLOR | TRANSITION, nullptr),
+            StyleParam("Transition 1", TRANSITION, nullptr),
+            StyleParam("Transition or Color #", COLOR | TRANSITION, nullptr),
             ),
         RUN(blade) {
             if (runIndex == -1) return;
@@ -844,7 +917,7 @@ TRANS(TrConcat, "Concatenate", -1,
 // to second color. Menant to be used with TrConcat
 TRANS(TrDelayX, "Delay", 0,
         PARAMS(
-            new StyleParam("Time (ms)", FUNCTION, nullptr),
+            StyleParam("Time (ms)", FUNCTION, nullptr),
             ),
         RUN() { update(0); }
         GETCOLOR(colorA, colorB,) {
@@ -854,7 +927,7 @@ TRANS(TrDelayX, "Delay", 0,
 
 TRANSW(TrDelay, "Delay", TrDelayX,
         PARAMS(
-            new NumberParam("Time (ms)", 1000),
+            NumberParam("Time (ms)", 1000),
             ),
         RUNW(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, FunctionStyle::get("Int")(PARAMVEC()));
@@ -876,10 +949,10 @@ TRANSW(TrDelay, "Delay", TrDelayX,
 // wav file, -1 is random wav LOCATION = -1 is random
 TRANS(TrDoEffectX, "Transition With Effect", -1,
         PARAMS(
-            new StyleParam("Transition", TRANSITION, nullptr),
-            new StyleParam("Effect To Trigger", EFFECT, nullptr),
-            new StyleParam("Audio File Number for Effect", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(-1))),
-            new StyleParam("Location on Blade", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(-1))),
+            StyleParam("Transition", TRANSITION, nullptr),
+            StyleParam("Effect To Trigger", EFFECT, nullptr),
+            StyleParam("Audio File Number for Effect", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(-1))),
+            StyleParam("Location on Blade", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(-1))),
             ),
         RUN(blade) {
             transition = STYLECAST(TransitionStyle, getParamStyle(0));
@@ -893,7 +966,7 @@ TRANS(TrDoEffectX, "Transition With Effect", -1,
             // location is a float here in ProffieOS, but there's no point
             // because it's just multiplied by 32768 and cast back to a uint16_t
             auto location{locationStyle->getInt(0)};
-            if (location == -1) location = ProffieUtils::random() % 32768;
+            if (location == -1) location = blade.getRandom().next() % 32768;
 
             if (shouldBegin) {
                 if (blade.isOn()) {
@@ -929,14 +1002,14 @@ TRANS(TrDoEffectX, "Transition With Effect", -1,
 
 TRANSW(TrDoEffect, "Transition With Effect", TrDoEffectX,
         PARAMS(
-            new StyleParam("Transition", TRANSITION, nullptr),
-            new StyleParam("Effect To Trigger", EFFECT, nullptr),
-            new NumberParam("Audio File Number for Effect", -1),
-            new NumberParam("Location on Blade", -1),
+            StyleParam("Transition", TRANSITION, nullptr),
+            StyleParam("Effect To Trigger", EFFECT, nullptr),
+            NumberParam("Audio File Number for Effect", -1),
+            NumberParam("Location on Blade", -1),
             ),
         RUNW(blade) {
-            pBase.setParam(0, const_cast<BladeStyle*>(getParamStyle(0)));
-            pBase.setParam(1, const_cast<BladeStyle*>(getParamStyle(1)));
+            pBase.setParam(0, borrow(getParamStyle(0)));
+            pBase.setParam(1, borrow(getParamStyle(1)));
             if (!pBase.getParamStyle(2)) pBase.setParam(2, FunctionStyle::get("Int")(PARAMVEC()));
             const_cast<BladeStyle*>(getParamStyle(2))->setParam(0, getParamNumber(2));
             if (!pBase.getParamStyle(3)) pBase.setParam(3, FunctionStyle::get("Int")(PARAMVEC()));
@@ -952,10 +1025,10 @@ TRANSW(TrDoEffect, "Transition With Effect", TrDoEffectX,
 // the blade is off.
 TRANS(TrDoEffectAlwaysX, "Transition with Effect (Always)", -1,
         PARAMS(
-            new StyleParam("Transition", TRANSITION, nullptr),
-            new StyleParam("Effect To Trigger", EFFECT, nullptr),
-            new StyleParam("Audio File Number for Effect", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(-1))),
-            new StyleParam("Location on Blade", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(-1))),
+            StyleParam("Transition", TRANSITION, nullptr),
+            StyleParam("Effect To Trigger", EFFECT, nullptr),
+            StyleParam("Audio File Number for Effect", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(-1))),
+            StyleParam("Location on Blade", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(-1))),
             ),
         RUN(blade) {
             transition = STYLECAST(TransitionStyle, getParamStyle(0));
@@ -963,7 +1036,7 @@ TRANS(TrDoEffectAlwaysX, "Transition with Effect (Always)", -1,
             auto locationStyle{STYLECAST(FunctionStyle, getParamStyle(3))};
 
             auto location{locationStyle->getInt(0)};
-            if (location == -1) location = ProffieUtils::random() % 32768;
+            if (location == -1) location = blade.getRandom().next() % 32768;
             if (shouldBegin) {
                 auto wavNum{audioNumStyle->getInt(0)};
                 auto effectStyle{STYLECAST(EffectStyle, getParamStyle(1))};
@@ -981,14 +1054,14 @@ TRANS(TrDoEffectAlwaysX, "Transition with Effect (Always)", -1,
 
 TRANSW(TrDoEffectAlways, "Transition With Effect (Always)", TrDoEffectAlwaysX,
         PARAMS(
-            new StyleParam("Transition", TRANSITION, nullptr),
-            new StyleParam("Effect To Trigger", EFFECT, nullptr),
-            new NumberParam("Audio File Number for Effect", -1),
-            new NumberParam("Location on Blade", -1),
+            StyleParam("Transition", TRANSITION, nullptr),
+            StyleParam("Effect To Trigger", EFFECT, nullptr),
+            NumberParam("Audio File Number for Effect", -1),
+            NumberParam("Location on Blade", -1),
             ),
         RUNW(blade) {
-            pBase.setParam(0, const_cast<BladeStyle*>(getParamStyle(0)));
-            pBase.setParam(1, const_cast<BladeStyle*>(getParamStyle(1)));
+            pBase.setParam(0, borrow(getParamStyle(0)));
+            pBase.setParam(1, borrow(getParamStyle(1)));
             if (!pBase.getParamStyle(2)) pBase.setParam(2, FunctionStyle::get("Int")(PARAMVEC()));
             const_cast<BladeStyle*>(getParamStyle(2))->setParam(0, getParamNumber(2));
             if (!pBase.getParamStyle(3)) pBase.setParam(3, FunctionStyle::get("Int")(PARAMVEC()));
@@ -1009,16 +1082,16 @@ TRANSW(TrDoEffectAlways, "Transition With Effect (Always)", TrDoEffectAlwaysX,
 // MILLIS_FUNCTION.
 TRANS(TrExtendX, "Freeze At End", -1,
         PARAMS(
-            new StyleParam("Freeze Time (ms)", FUNCTION, nullptr),
-            new StyleParam("Transition", TRANSITION, nullptr)
+            StyleParam("Freeze Time (ms)", FUNCTION, nullptr),
+            StyleParam("Transition", TRANSITION, nullptr)
             ),
         RUN(blade) {
             transition = STYLECAST(TransitionStyle, getParamStyle(1));
             transition->run(blade);
 
             if (transition->isDone() && running) {
-                if (extendStartTime == -1) extendStartTime = Utility::getTimeMS();
-                auto now{Utility::getTimeMS()};
+                auto now{blade.getTimeMS()};
+                if (extendStartTime == -1) extendStartTime = now;
                 auto freezeTime{STYLECAST(FunctionStyle, getParamStyle(0))->getInt(0)};
                 if (static_cast<int32_t>(now - extendStartTime) > freezeTime) {
                     extendStartTime = -1;
@@ -1038,14 +1111,14 @@ TRANS(TrExtendX, "Freeze At End", -1,
 
 TRANSW(TrExtend, "Freeze At End", TrExtendX,
         PARAMS(
-            new NumberParam("Freeze Time (ms)", 1000),
-            new StyleParam("Transition", TRANSITION, nullptr)
+            NumberParam("Freeze Time (ms)", 1000),
+            StyleParam("Transition", TRANSITION, nullptr)
             ),
         RUNW(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, FunctionStyle::get("Int")(PARAMVEC()));
             const_cast<BladeStyle*>(pBase.getParamStyle(0))->setParam(0, getParamNumber(0));
 
-            pBase.setParam(1, const_cast<BladeStyle*>(getParamStyle(1)));
+            pBase.setParam(1, borrow(getParamStyle(1)));
 
             pBase.run(blade);
             }
@@ -1059,12 +1132,13 @@ TRANSW(TrExtend, "Freeze At End", TrExtendX,
 // Linear fading between two colors in specified number of milliseconds.
 TRANS(TrFadeX, "Fade", 0,
         PARAMS(
-            new StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
+            StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
             ),
         RUN() {
             fade = update(16384);
         }
         GETCOLOR(colorA, colorB,) { return mixColors(colorA, colorB, fade, 14); }
+        RENDER(frameA, frameB, out) { out.mix(frameA, frameB, fade, 14); }
 
         private:
             uint32_t fade;
@@ -1072,7 +1146,7 @@ TRANS(TrFadeX, "Fade", 0,
 
 TRANSW(TrFade, "Fade", TrFadeX,
         PARAMS(
-            new NumberParam("Time (ms)", 1000),
+            NumberParam("Time (ms)", 1000),
             ),
         RUNW(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, FunctionStyle::get("Int")(PARAMVEC()));
@@ -1092,13 +1166,14 @@ TRANSW(TrFade, "Fade", TrFadeX,
 // slows down at the end.
 TRANS(TrSmoothFadeX, "Smooth Fade", 0,
         PARAMS(
-            new StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
+            StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
             ),
         RUN() {
             auto val{static_cast<int32_t>(update(16384))};
             fade = (((val * val) >> 14) * ((3 << 14) - val)) >> 16;
         }
         GETCOLOR(colorA, colorB,) { return mixColors(colorA, colorB, fade, 14); }
+        RENDER(frameA, frameB, out) { out.mix(frameA, frameB, fade, 14); }
 
         private:
             uint32_t fade;
@@ -1106,7 +1181,7 @@ TRANS(TrSmoothFadeX, "Smooth Fade", 0,
 
 TRANSW(TrSmoothFade, "Smooth Fade", TrSmoothFadeX,
         PARAMS(
-            new NumberParam("Time (ms)", 1000),
+            NumberParam("Time (ms)", 1000),
             ),
         RUNW(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, FunctionStyle::get("Int")(PARAMVEC()));
@@ -1133,7 +1208,7 @@ TRANS(TrInstant, "Instant", -1,
 // Runs the specified transition in a loop forever.
 TRANS(TrLoop, "Loop Forever", -1,
         PARAMS(
-            new StyleParam("Transition", TRANSITION, nullptr),
+            StyleParam("Transition", TRANSITION, nullptr),
             ),
         RUN(blade) {
             transition = STYLECAST(TransitionStyle, getParamStyle(0));
@@ -1157,8 +1232,8 @@ TRANS(TrLoop, "Loop Forever", -1,
 // Runs the specified transition N times.
 TRANS(TrLoopNX, "Loop", -1,
         PARAMS(
-            new StyleParam("Number of Loops", FUNCTION, nullptr),
-            new StyleParam("Transition", TRANSITION, nullptr)
+            StyleParam("Number of Loops", FUNCTION, nullptr),
+            StyleParam("Transition", TRANSITION, nullptr)
             ),
         RUN(blade) {
             auto numLoopsStyle{STYLECAST(FunctionStyle, getParamStyle(0))};
@@ -1183,14 +1258,14 @@ TRANS(TrLoopNX, "Loop", -1,
 
 TRANSW(TrLoopN, "Loop", TrLoopNX,
         PARAMS(
-            new NumberParam("Number of Loops", 1),
-            new StyleParam("Transition", TRANSITION, nullptr)
+            NumberParam("Number of Loops", 1),
+            StyleParam("Transition", TRANSITION, nullptr)
             ),
         RUNW(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, FunctionStyle::get("Int")(PARAMVEC()));
             const_cast<BladeStyle*>(pBase.getParamStyle(0))->setParam(0, getParamNumber(0));
 
-            pBase.setParam(0, const_cast<BladeStyle*>(getParamStyle(1)));
+            pBase.setParam(0, borrow(getParamStyle(1)));
 
             pBase.run(blade);
         }
@@ -1205,9 +1280,9 @@ TRANSW(TrLoopN, "Loop", TrLoopNX,
 // transition away from it, and when OUT is done, the transition is done.
 TRANS(TrLoopUntil, "Loop Until", -1,
         PARAMS(
-            new StyleParam("End Pulse", FUNCTION, nullptr),
-            new StyleParam("Transition", TRANSITION, nullptr),
-            new StyleParam("End Transition", TRANSITION, nullptr),
+            StyleParam("End Pulse", FUNCTION, nullptr),
+            StyleParam("Transition", TRANSITION, nullptr),
+            StyleParam("End Transition", TRANSITION, nullptr),
             ),
         RUN(blade) {
             transition = STYLECAST(TransitionStyle, getParamStyle(1));
@@ -1251,15 +1326,15 @@ TRANS(TrLoopUntil, "Loop Until", -1,
 // transitions.
 TRANS(TrRandom, "Random", -1,
         PARAMS(
-            new StyleParam("Transition 1", TRANSITION, nullptr),
-            new StyleParam("Transition #", TRANSITION | VARIADIC, nullptr),
+            StyleParam("Transition 1", TRANSITION, nullptr),
+            StyleParam("Transition #", TRANSITION | VARIADIC, nullptr),
             ),
         RUN(blade) {
             if (shouldBegin) {
                 shouldBegin = false;
                 // Last variadic will be nullptr
                 auto numParams{getParams().size() - 1};
-                auto selectIndex{ProffieUtils::random() % numParams};
+                auto selectIndex{blade.getRandom().next() % numParams};
                 selected = STYLECAST(TransitionStyle, getParamStyle(selectIndex));
                 selected->begin();
             }
@@ -1291,9 +1366,9 @@ TRANS(TrRandom, "Random", -1,
 // with Int<0> representing first transition
 TRANS(TrSelect, "Selection", -1,
         PARAMS(
-            new StyleParam("Selection", FUNCTION, nullptr),
-            new StyleParam("Transition 1", TRANSITION, nullptr),
-            new StyleParam("Transition #", TRANSITION | VARIADIC, nullptr),
+            StyleParam("Selection", FUNCTION, nullptr),
+            StyleParam("Transition 1", TRANSITION, nullptr),
+            StyleParam("Transition #", TRANSITION | VARIADIC, nullptr),
             ),
         RUN(blade) {
             auto selectStyle{STYLECAST(FunctionStyle, getParamStyle(0))};
@@ -1336,8 +1411,8 @@ TRANS(TrSelect, "Selection", -1,
 // will wrap back around to TR1.
 TRANS(TrSequence, "Sequence", -1,
         PARAMS(
-            new StyleParam("Transition 1", TRANSITION, nullptr),
-            new StyleParam("Transition #", TRANSITION | VARIADIC, nullptr),
+            StyleParam("Transition 1", TRANSITION, nullptr),
+            StyleParam("Transition #", TRANSITION | VARIADIC, nullptr),
             ),
         RUN(blade) {
             if (shouldBegin) {
@@ -1378,11 +1453,11 @@ TRANS(TrSequence, "Sequence", -1,
 // transitions that start and begin with the same color.
 TRANS(TrWaveX, "Wave", 1,
         PARAMS(
-            new StyleParam("Color", COLOR, nullptr),
-            new StyleParam("Fadeout Time (ms)", FUNCTION | TIMEFUNC, FunctionStyle::get("Int")(PARAMVEC(200))),
-            new StyleParam("Wave Size", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(100))),
-            new StyleParam("Wave Time (ms)", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(400))),
-            new StyleParam("Wave Position", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(16384)))
+            StyleParam("Color", COLOR, nullptr),
+            StyleParam("Fadeout Time (ms)", FUNCTION | TIMEFUNC, FunctionStyle::get("Int")(PARAMVEC(200))),
+            StyleParam("Wave Size", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(100))),
+            StyleParam("Wave Time (ms)", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(400))),
+            StyleParam("Wave Position", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(16384)))
             ),
         RUN(blade) {
             auto waveSizeStyle{STYLECAST(FunctionStyle, getParamStyle(2))};
@@ -1403,7 +1478,7 @@ TRANS(TrWaveX, "Wave", 1,
             mix = 32768 - update(32768);
             numLeds = blade.numLeds;
             auto waveTime{waveTimeStyle->getInt(0)};
-            offset = ((Utility::getTimeMS() - getStartMillis()) * 32768) / /* prevent div by 0 */ (waveTime ? waveTime : 1);
+            offset = ((getNowMillis() - getStartMillis()) * 32768) / /* prevent div by 0 */ (waveTime ? waveTime : 1);
         }
         GETCOLOR(colorA,, led) {
             auto dist{std::abs(center - ((led * 32768) / numLeds))};
@@ -1431,10 +1506,10 @@ TRANS(TrWaveX, "Wave", 1,
 // and begin with the same color.
 TRANS(TrSparkX, "Spark", 2,
         PARAMS(
-            new StyleParam("Color", COLOR, nullptr),
-            new StyleParam("Size", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(100))),
-            new StyleParam("Time (ms)", FUNCTION | TIMEFUNC, FunctionStyle::get("Int")(PARAMVEC(400))),
-            new StyleParam("Position", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(16384)))
+            StyleParam("Color", COLOR, nullptr),
+            StyleParam("Size", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(100))),
+            StyleParam("Time (ms)", FUNCTION | TIMEFUNC, FunctionStyle::get("Int")(PARAMVEC(400))),
+            StyleParam("Position", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(16384)))
             ),
         RUN(blade) {
             auto sizeStyle{STYLECAST(FunctionStyle, getParamStyle(1))};
@@ -1480,7 +1555,7 @@ TRANS(TrSparkX, "Spark", 2,
 // number of milliseconds.
 TRANS(TrWipeX, "Wipe", 0,
         PARAMS(
-            new StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr)
+            StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr)
             ),
         RUN(blade) {
             fade = update(256 * blade.numLeds);
@@ -1496,7 +1571,7 @@ TRANS(TrWipeX, "Wipe", 0,
 
 TRANSW(TrWipe, "Wipe", TrWipeX,
         PARAMS(
-            new NumberParam("Time (ms)", 1000)
+            NumberParam("Time (ms)", 1000)
             ),
         RUNW(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, FunctionStyle::get("Int")(PARAMVEC()));
@@ -1514,7 +1589,7 @@ TRANSW(TrWipe, "Wipe", TrWipeX,
 // Like TrWipe, but from tip to base.
 TRANS(TrWipeInX, "Wipe In", 0,
         PARAMS(
-            new StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr)
+            StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr)
             ),
         RUN(blade) {
             fade = Range(
@@ -1533,7 +1608,7 @@ TRANS(TrWipeInX, "Wipe In", 0,
 
 TRANSW(TrWipeIn, "Wipe In", TrWipeInX,
         PARAMS(
-            new NumberParam("Time (ms)", 1000)
+            NumberParam("Time (ms)", 1000)
             ),
         RUNW(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, FunctionStyle::get("Int")(PARAMVEC()));
@@ -1562,23 +1637,23 @@ TRANSW(TrWipeIn, "Wipe In", TrWipeInX,
 // >
 TRANSW(TrWipeSparkTipX, "Wipe With Tip Spark", TrJoin,
         PARAMS(
-            new StyleParam("Spark Color", COLOR, nullptr),
-            new StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
-            new StyleParam("Spark Size", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(400))),
+            StyleParam("Spark Color", COLOR, nullptr),
+            StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
+            StyleParam("Spark Size", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(400))),
             ),
         RUNW(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, TransitionStyle::get("TrWipeX")(PARAMVEC()));
             if (!pBase.getParamStyle(1)) pBase.setParam(1, TransitionStyle::get("TrSparkX")(PARAMVEC()));
 
-            auto timeStyle{const_cast<BladeStyle*>(getParamStyle(1))};
+            const auto timeStyle{borrow(getParamStyle(1))};
 
             auto wipeStyle{STYLECAST(TransitionStyle, pBase.getParamStyle(0))};
             wipeStyle->setParam(0, timeStyle);
 
             auto sparkStyle{STYLECAST(TransitionStyle, pBase.getParamStyle(1))};
             if (!sparkStyle->getParamStyle(3)) sparkStyle->setParam(3, FunctionStyle::get("Int")(PARAMVEC(0)));
-            sparkStyle->setParam(0, const_cast<BladeStyle*>(getParamStyle(0)));
-            sparkStyle->setParam(1, const_cast<BladeStyle*>(getParamStyle(2)));
+            sparkStyle->setParam(0, borrow(getParamStyle(0)));
+            sparkStyle->setParam(1, borrow(getParamStyle(2)));
             sparkStyle->setParam(2, timeStyle);
 
             pBase.run(blade);
@@ -1587,12 +1662,12 @@ TRANSW(TrWipeSparkTipX, "Wipe With Tip Spark", TrJoin,
 
 TRANSW(TrWipeSparkTip, "Wipe With Tip Spark", TrWipeSparkTipX,
         PARAMS(
-            new StyleParam("Spark Color", COLOR, nullptr),
-            new NumberParam("Time (ms)", 1000), 
-            new NumberParam("Spark Size", 400)
+            StyleParam("Spark Color", COLOR, nullptr),
+            NumberParam("Time (ms)", 1000), 
+            NumberParam("Spark Size", 400)
             ),
         RUNW(blade) {
-            pBase.setParam(0, const_cast<BladeStyle*>(getParamStyle(0)));
+            pBase.setParam(0, borrow(getParamStyle(0)));
 
             if (!pBase.getParamStyle(1)) pBase.setParam(1, FunctionStyle::get("Int")(PARAMVEC()));
             const_cast<BladeStyle*>(pBase.getParamStyle(1))->setParam(0, getParamNumber(1));
@@ -1621,23 +1696,23 @@ TRANSW(TrWipeSparkTip, "Wipe With Tip Spark", TrWipeSparkTipX,
 // >
 TRANSW(TrWipeInSparkTipX, "Wipe In With Tip Spark", TrJoin,
         PARAMS(
-            new StyleParam("Spark Color", COLOR, nullptr),
-            new StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
-            new StyleParam("Spark Size", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(400))),
+            StyleParam("Spark Color", COLOR, nullptr),
+            StyleParam("Time (ms)", FUNCTION | TIMEFUNC, nullptr),
+            StyleParam("Spark Size", FUNCTION, FunctionStyle::get("Int")(PARAMVEC(400))),
             ),
         RUNW(blade) {
             if (!pBase.getParamStyle(0)) pBase.setParam(0, TransitionStyle::get("TrWipeX")(PARAMVEC()));
             if (!pBase.getParamStyle(1)) pBase.setParam(1, TransitionStyle::get("TrSparkX")(PARAMVEC()));
 
-            auto timeStyle{const_cast<BladeStyle*>(getParamStyle(1))};
+            const auto timeStyle{borrow(getParamStyle(1))};
 
             auto wipeStyle{STYLECAST(TransitionStyle, pBase.getParamStyle(0))};
             wipeStyle->setParam(0, timeStyle);
 
             auto sparkStyle{STYLECAST(TransitionStyle, pBase.getParamStyle(1))};
             if (!sparkStyle->getParamStyle(3)) sparkStyle->setParam(3, FunctionStyle::get("Int")(PARAMVEC(32768)));
-            sparkStyle->setParam(0, const_cast<BladeStyle*>(getParamStyle(0)));
-            sparkStyle->setParam(1, const_cast<BladeStyle*>(getParamStyle(2)));
+            sparkStyle->setParam(0, borrow(getParamStyle(0)));
+            sparkStyle->setParam(1, borrow(getParamStyle(2)));
             sparkStyle->setParam(2, timeStyle);
 
             pBase.run(blade);
@@ -1646,12 +1721,12 @@ TRANSW(TrWipeInSparkTipX, "Wipe In With Tip Spark", TrJoin,
 
 TRANSW(TrWipeInSparkTip, "Wipe In With Tip Spark", TrWipeInSparkTipX,
         PARAMS(
-            new StyleParam("Spark Color", COLOR, nullptr),
-            new NumberParam("Time (ms)", 1000), 
-            new NumberParam("Spark Size", 400)
+            StyleParam("Spark Color", COLOR, nullptr),
+            NumberParam("Time (ms)", 1000), 
+            NumberParam("Spark Size", 400)
             ),
         RUNW(blade) {
-            pBase.setParam(0, const_cast<BladeStyle*>(getParamStyle(0)));
+            pBase.setParam(0, borrow(getParamStyle(0)));
 
             if (!pBase.getParamStyle(1)) pBase.setParam(1, FunctionStyle::get("Int")(PARAMVEC()));
             const_cast<BladeStyle*>(pBase.getParamStyle(1))->setParam(0, getParamNumber(1));
@@ -20,9 +20,12 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <span>
+
 #include "styles/bladestyle.h"
 #include "stylepreview/blade.h"
 #include "styles/colordata.h"
+#include "styles/ledframe.h"
 
 namespace BladeStyles {
 
@@ -96,12 +99,25 @@ public:
     [[nodiscard]] virtual bool shouldRestart() const = 0;
     [[nodiscard]] virtual uint32_t getStartMillis() const = 0;
     virtual ColorData getColor(const ColorData&, const ColorData&, int32_t) = 0;
+    /**
+     * Batched getColor() for LEDs [ledBegin, ledBegin + out.size())
+     *
+     * out may alias colorsA or colorsB, so overrides must finish
+     * reading each LED's inputs before writing that LED.
+     */
+    virtual void getColors(std::span<const ColorData> colorsA, std::span<const ColorData> colorsB, std::span<ColorData> out, int32_t ledBegin = 0);
+    /**
+     * getColors() for whole frames. out may be frameA or frameB.
+     *
+     * The default goes through getColors() in chunks.
+     */
+    virtual void render(const LedFrame& frameA, const LedFrame& frameB, LedFrame& out);
 
     static StyleGenerator get(const std::string& styleName);
     static const StyleMap& getMap();
 
 protected:
-    TransitionStyle(const char* osName, const char* humanName, const std::vector<Param*>&);
+    TransitionStyle(const char* osName, const char* humanName, const std::vector<Param>&);
 
 private:
     static const StyleMap map;
@@ -20,12 +20,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "stylepreview/profiler.h"
 #include "styles/bladestyle.h"
 #include "styles/elements/colorstyles.h"
 
 using namespace BladeStyles;
 
-WrapperStyle::WrapperStyle(const char* osName, const char* humanName, const std::vector<Param*>& params) :
+WrapperStyle::WrapperStyle(const char* osName, const char* humanName, const std::vector<Param>& params) :
     ColorStyle(osName, humanName, params, WRAPPER) {}
 
 
@@ -38,8 +39,18 @@ StyleGenerator WrapperStyle::get(const std::string& styleName) {
 
 const StyleMap& WrapperStyle::getMap() { return map; }
 
-#define RUN(varname) virtual void run(StylePreview::Blade& varname) override
+// The element's body goes in the *Impl function, so every call can be profiled
+#define RUN(varname) \
+    virtual void run(StylePreview::Blade& blade) override { PROFILE_STYLE("run"); runImpl(blade); } \
+    void runImpl(StylePreview::Blade& varname)
+// Called per LED, so not profiled
 #define GETCOLOR(varname) virtual ColorData getColor(int32_t varname) override
+#define GETCOLORS(outvarname, beginvarname) \
+    virtual void getColors(std::span<ColorData> out, int32_t ledBegin) override { PROFILE_STYLE("getColors"); getColorsImpl(out, ledBegin); } \
+    void getColorsImpl(std::span<ColorData> outvarname, int32_t beginvarname)
+#define RENDER(outvarname) \
+    virtual void render(LedFrame& out) override { PROFILE_STYLE("render"); renderImpl(out); } \
+    void renderImpl(LedFrame& outvarname)
 
 #define WRAPPER(osName, humanName, params, ...) \
     class osName : public WrapperStyle { \
@@ -51,13 +62,15 @@ const StyleMap& WrapperStyle::getMap() { return map; }
 // NEED A BETTER HUMAN NAME for all these
 WRAPPER(StylePtr, "StylePtr",
         PARAMS(
-            new StyleParam("Style Contents", COLOR, nullptr)
+            StyleParam("Style Contents", COLOR, nullptr)
             ),
         RUN(blade) {
             style = STYLECAST(ColorStyle, getParamStyle(0));
             style->run(blade);
         }
         GETCOLOR(led) { return style->getColor(led); }
+        GETCOLORS(out, ledBegin) { style->getColors(out, ledBegin); }
+        RENDER(out) { style->render(out); }
 
         private:
             ColorStyle* style;
@@ -65,13 +78,15 @@ WRAPPER(StylePtr, "StylePtr",
 
 WRAPPER(ChargingStylePtr, "ChargingStylePtr",
         PARAMS(
-            new StyleParam("Style Contents", COLOR, nullptr)
+            StyleParam("Style Contents", COLOR, nullptr)
             ),
         RUN(blade) {
             style = STYLECAST(ColorStyle, getParamStyle(0));
             style->run(blade);
         }
         GETCOLOR(led) { return style->getColor(led); }
+        GETCOLORS(out, ledBegin) { style->getColors(out, ledBegin); }
+        RENDER(out) { style->render(out); }
 
         private:
             ColorStyle* style;
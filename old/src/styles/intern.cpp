@@ -0,0 +1,139 @@
+#include "intern.h"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * styles/intern.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+#include "styles/bladestyle.h"
+
+using namespace BladeStyles;
+
+static void hashCombine(size_t& hash, size_t value);
+
+InternTable::~InternTable() { clear(); }
+
+BladeStyle* InternTable::intern(BladeStyle* style) {
+    if (!style) return nullptr;
+
+    // Already interned, nothing to do (and its children can't change).
+    const auto styleIt{mStyles.find(style)};
+    if (styleIt != mStyles.end() && *styleIt == style) return style;
+
+    // Interning changes params, so don't do that to a style someone else
+    // is using.
+    if (style->isShared()) {
+        auto *copy{style->clone()};
+        if (!copy) return style;
+        BladeStyle::release(style);
+        style = copy;
+    }
+    internParams(*style);
+
+    const auto [ internedIt, inserted ]{mStyles.insert(style)};
+    if (inserted) {
+        style->retain();
+        return style;
+    }
+
+    auto *interned{*internedIt};
+    interned->retain();
+    BladeStyle::release(style);
+    return interned;
+}
+
+void InternTable::internParams(BladeStyle& style) {
+    const auto& params{style.getParams()};
+    for (size_t idx{0}; idx < params.size(); idx++) {
+        const auto *child{params[idx].getType() & STYLETYPE ? params[idx].getStyle() : nullptr};
+        if (!child) continue;
+
+        const auto childIt{mStyles.find(const_cast<BladeStyle*>(child))};
+        if (childIt != mStyles.end() && *childIt == child) continue;
+
+        auto *detached{style.detachParamStyle(idx)};
+        if (!detached) continue;
+        (void)style.setParam(idx, intern(detached));
+    }
+}
+
+void InternTable::purge() {
+    // Releasing a style can leave its children unused too, so go until
+    // nothing changes.
+    auto purged{true};
+    while (purged) {
+        purged = false;
+        for (auto styleIt{mStyles.begin()}; styleIt != mStyles.end();) {
+            if ((*styleIt)->isShared()) {
+                ++styleIt;
+                continue;
+            }
+
+            auto *style{*styleIt};
+            styleIt = mStyles.erase(styleIt);
+            BladeStyle::release(style);
+            purged = true;
+        }
+    }
+}
+
+void InternTable::clear() {
+    for (auto *style : mStyles) BladeStyle::release(style);
+    mStyles.clear();
+}
+
+size_t InternTable::Hash::operator()(const BladeStyle* style) const {
+    size_t hash{std::hash<std::string_view>{}(style->osName)};
+    hashCombine(hash, std::hash<std::string>{}(style->comment));
+    for (const auto& param : style->getParams()) {
+        hashCombine(hash, param.getType());
+        if (param.getType() & STYLETYPE) {
+            hashCombine(hash, std::hash<const BladeStyle*>{}(param.getStyle()));
+        } else {
+            hashCombine(hash, static_cast<uint32_t>(param.getNum()));
+        }
+    }
+    return hash;
+}
+
+bool InternTable::Equal::operator()(const BladeStyle* lhs, const BladeStyle* rhs) const {
+    if (lhs == rhs) return true;
+    if (std::strcmp(lhs->osName, rhs->osName) != 0) return false;
+    if (lhs->comment != rhs->comment) return false;
+
+    const auto& lhsParams{lhs->getParams()};
+    const auto& rhsParams{rhs->getParams()};
+    if (lhsParams.size() != rhsParams.size()) return false;
+    for (size_t idx{0}; idx < lhsParams.size(); idx++) {
+        const auto& lhsParam{lhsParams[idx]};
+        const auto& rhsParam{rhsParams[idx]};
+        if (lhsParam.getType() != rhsParam.getType()) return false;
+        if (lhsParam.getType() & STYLETYPE) {
+            if (lhsParam.getStyle() != rhsParam.getStyle()) return false;
+        } else if (lhsParam.getNum() != rhsParam.getNum()) return false;
+    }
+    return true;
+}
+
+static void hashCombine(size_t& hash, size_t value) {
+    hash ^= value + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+}
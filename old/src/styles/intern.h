@@ -0,0 +1,78 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * styles/intern.h
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstddef>
+#include <unordered_set>
+
+namespace BladeStyles {
+
+class BladeStyle;
+
+/**
+ * Keeps one copy of each distinct style, so identical subtrees (the same
+ * blast or lockup layer in every preset, etc.) are stored once.
+ *
+ * Styles are compared by osName, comment, and params. Children are
+ * interned first, so they can be compared by address. Interned styles
+ * are always shared (the table holds a reference), so they're copied on
+ * write like any other shared style.
+ *
+ * Not thread safe.
+ */
+class InternTable {
+public:
+    InternTable() = default;
+    InternTable(const InternTable&) = delete;
+    InternTable& operator=(const InternTable&) = delete;
+    ~InternTable();
+
+    /**
+     * Takes over the caller's reference to style, and returns a reference
+     * to the interned equivalent, which may be style itself.
+     */
+    [[nodiscard]] BladeStyle* intern(BladeStyle* style);
+    /**
+     * Intern style's children, but not style itself, e.g. for a preset's
+     * top-level style, which is going to be edited in place.
+     */
+    void internParams(BladeStyle& style);
+
+    /**
+     * Drop any styles nothing but the table is using anymore.
+     */
+    void purge();
+    void clear();
+
+    [[nodiscard]] size_t size() const { return mStyles.size(); }
+
+private:
+    struct Hash {
+        size_t operator()(const BladeStyle*) const;
+    };
+    struct Equal {
+        bool operator()(const BladeStyle*, const BladeStyle*) const;
+    };
+
+    std::unordered_set<BladeStyle*, Hash, Equal> mStyles;
+};
+
+} // namespace BladeStyles
+
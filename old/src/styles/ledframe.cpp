@@ -0,0 +1,89 @@
+#include "ledframe.h"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * styles/ledframe.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include "styles/colorkernels.h"
+
+using namespace BladeStyles;
+
+LedFrame::LedFrame(int32_t numLeds) { resize(numLeds); }
+
+void LedFrame::resize(int32_t numLeds) {
+    mNumLeds = std::max(numLeds, 0);
+    mPlanes.resize(static_cast<size_t>(mNumLeds) * NUM_PLANES);
+}
+
+std::span<uint32_t> LedFrame::plane(Plane plane) {
+    return { mPlanes.data() + (static_cast<size_t>(plane) * mNumLeds), static_cast<size_t>(mNumLeds) };
+}
+
+std::span<const uint32_t> LedFrame::plane(Plane plane) const {
+    return { mPlanes.data() + (static_cast<size_t>(plane) * mNumLeds), static_cast<size_t>(mNumLeds) };
+}
+
+ColorData LedFrame::getColor(int32_t led) const {
+    return ColorData{
+        .red = red()[led],
+        .green = green()[led],
+        .blue = blue()[led],
+        .alpha = alpha()[led],
+    };
+}
+
+void LedFrame::setColor(int32_t led, const ColorData& color) {
+    red()[led] = color.red;
+    green()[led] = color.green;
+    blue()[led] = color.blue;
+    alpha()[led] = color.alpha;
+}
+
+void LedFrame::setColors(std::span<const ColorData> colors, int32_t ledBegin) {
+    for (const auto& color : colors) setColor(ledBegin++, color);
+}
+
+void LedFrame::fill(const ColorData& color) {
+    std::ranges::fill(red(), color.red);
+    std::ranges::fill(green(), color.green);
+    std::ranges::fill(blue(), color.blue);
+    std::ranges::fill(alpha(), color.alpha);
+}
+
+void LedFrame::mix(const LedFrame& frameA, const LedFrame& frameB, std::span<const uint32_t> weights, int32_t shift) {
+    for (const auto plane : { RED, GREEN, BLUE, ALPHA }) {
+        Kernels::mix(frameA.plane(plane), frameB.plane(plane), weights, this->plane(plane), shift);
+    }
+}
+
+void LedFrame::mix(const LedFrame& frameA, const LedFrame& frameB, uint32_t weight, int32_t shift) {
+    for (const auto plane : { RED, GREEN, BLUE, ALPHA }) {
+        Kernels::mix(frameA.plane(plane), frameB.plane(plane), weight, this->plane(plane), shift);
+    }
+}
+
+void LedFrame::paintOver(const LedFrame& layer) {
+    constexpr int32_t ALPHA_SHIFT{15};
+    for (const auto plane : { RED, GREEN, BLUE }) {
+        Kernels::mix(this->plane(plane), layer.plane(plane), layer.alpha(), this->plane(plane), ALPHA_SHIFT);
+    }
+    Kernels::compositeAlpha(alpha(), layer.alpha(), alpha());
+}
+
@@ -0,0 +1,92 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * styles/ledframe.h
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "styles/colordata.h"
+
+namespace BladeStyles {
+
+/**
+ * Colors for a whole blade, stored as separate red, green, blue, and alpha
+ * planes (same 0-32768 scale as ColorData) so they can be operated on with
+ * Kernels.
+ *
+ * Storage is only reallocated when the frame grows, so one frame can be
+ * kept and reused for every render.
+ */
+class LedFrame {
+public:
+    LedFrame() = default;
+    explicit LedFrame(int32_t numLeds);
+
+    void resize(int32_t numLeds);
+    [[nodiscard]] int32_t size() const { return mNumLeds; }
+
+    [[nodiscard]] std::span<uint32_t> red() { return plane(RED); }
+    [[nodiscard]] std::span<uint32_t> green() { return plane(GREEN); }
+    [[nodiscard]] std::span<uint32_t> blue() { return plane(BLUE); }
+    [[nodiscard]] std::span<uint32_t> alpha() { return plane(ALPHA); }
+    [[nodiscard]] std::span<const uint32_t> red() const { return plane(RED); }
+    [[nodiscard]] std::span<const uint32_t> green() const { return plane(GREEN); }
+    [[nodiscard]] std::span<const uint32_t> blue() const { return plane(BLUE); }
+    [[nodiscard]] std::span<const uint32_t> alpha() const { return plane(ALPHA); }
+
+    [[nodiscard]] ColorData getColor(int32_t led) const;
+    void setColor(int32_t led, const ColorData&);
+    /**
+     * Copy colors into LEDs [ledBegin, ledBegin + colors.size())
+     */
+    void setColors(std::span<const ColorData> colors, int32_t ledBegin = 0);
+    void fill(const ColorData&);
+
+    /**
+     * Set this frame to mixColors() of frameA and frameB for every LED,
+     * alpha included. Either frame may be this one.
+     */
+    void mix(const LedFrame& frameA, const LedFrame& frameB, std::span<const uint32_t> weights, int32_t shift);
+    void mix(const LedFrame& frameA, const LedFrame& frameB, uint32_t weight, int32_t shift);
+    /**
+     * Paint layer on top of this frame, using the layer's alpha.
+     */
+    void paintOver(const LedFrame& layer);
+
+private:
+    enum Plane {
+        RED,
+        GREEN,
+        BLUE,
+        ALPHA,
+        NUM_PLANES
+    };
+
+    [[nodiscard]] std::span<uint32_t> plane(Plane);
+    [[nodiscard]] std::span<const uint32_t> plane(Plane) const;
+
+    int32_t mNumLeds{0};
+    // NUM_PLANES planes of mNumLeds each, back to back.
+    std::vector<uint32_t> mPlanes;
+};
+
+} // namespace BladeStyles
+
@@ -21,108 +21,136 @@
 
 #include "log/logger.h"
 #include "styles/bladestyle.h"
-#include <algorithm>
 #include <cctype>
+#include <charconv>
 #include <climits>
 #include <cstddef>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 using namespace BladeStyles;
 
-struct TokenizedStyle {
-    std::string name;
-    std::string comment;
-
-    struct Param {
-        std::string rawStr;
-        std::string paramStr;
-        std::string comments;
-    };
-    std::vector<Param> params;
+/**
+ * Cursor over the full style string.
+ *
+ * Nested styles are parsed recursively from the same cursor, so each
+ * character is only visited once and nothing is copied out of the
+ * original string until it's actually stored in the BladeStyle.
+ */
+struct StyleParser {
+    std::string_view str{};
+    size_t pos{0};
+    /**
+     * Sorted, non-overlapping [begin, end) ranges of every comment,
+     * found once up front.
+     *
+     * Since the cursor only moves forward, `nextComment` is the only
+     * comment that could begin at or after `pos`, so skipping and
+     * attributing comments is just advancing it.
+     */
+    std::vector<std::pair<size_t, size_t>> commentRanges{};
+    size_t nextComment{0};
+    bool* foundStyle{nullptr};
+    const StyleAliases* aliases{nullptr};
+
+    [[nodiscard]] bool atEnd() const { return pos >= str.length(); }
+    [[nodiscard]] char peek() const { return atEnd() ? '\0' : str[pos]; }
 };
-static std::optional<TokenizedStyle> tokenizeStyle(const std::string &);
+
+static bool findComments(StyleParser&);
+static void skipIgnored(StyleParser&);
+static std::string getComments(const StyleParser&, size_t firstComment, size_t endComment);
+static std::string_view parseIdentifier(StyleParser&);
+static std::optional<int32_t> parseScalar(StyleParser&);
+static bool parseParam(StyleParser&, BladeStyle&, size_t idx);
+static BladeStyle* parseStyle(StyleParser&);
 
 static std::string typeToString(uint32_t);
 
-BladeStyle *BladeStyles::parseString(const std::string &styleStr, bool *foundStyle) {
-    auto styleTokens{tokenizeStyle(styleStr)};
-    if (!styleTokens) return nullptr;
+using AliasMap = std::unordered_map<const BladeStyle*, std::string>;
+using UseCounts = std::unordered_map<const BladeStyle*, uint32_t>;
 
-    if (foundStyle) *foundStyle = false;
+static std::optional<std::string> toString(const BladeStyle&, const AliasMap*);
+static void countUses(const BladeStyle&, UseCounts&);
+static void emitAliases(const BladeStyle&, const UseCounts&, AliasMap&, std::unordered_map<std::string_view, uint32_t>& nameCounts, AliasedStrings& out);
 
-    auto styleGen{get(styleTokens->name)};
-    if (!styleGen) {
-        Logger::error("Style not recognized: " + styleTokens->name);
-        return nullptr;
-    } 
-    if (foundStyle) *foundStyle = true;
+BladeStyle *BladeStyles::parseString(std::string_view styleStr, bool *foundStyle, const StyleAliases* aliases) {
+    StyleParser parser{
+        .str = styleStr,
+        .foundStyle = foundStyle,
+        .aliases = aliases,
+    };
+    if (!findComments(parser)) return nullptr;
 
-    auto *style{styleGen({})};
-    auto numParams{style->getParams().size()};
-    auto numTokenParams{styleTokens->params.size()};
-    if (
-            numTokenParams < numParams || 
-            (
-             numParams > 0 &&
-             (!(style->getParams().back()->getType() & VARIADIC)) && 
-             numTokenParams > numParams
-            )
-       ) {
-        Logger::error("Incorrect number of parameters for style: " + 
-                styleTokens->name + 
-                " (Expected " + 
-                std::to_string(numParams) +
-                " got " + 
-                std::to_string(numTokenParams) +
-                ")");
-        delete style;
-        return nullptr;
+    return parseStyle(parser);
+}
+
+std::optional<std::string> BladeStyles::asString(const BladeStyle& style) {
+    return toString(style, nullptr);
+}
+
+AliasedStrings BladeStyles::asAliasedStrings(const std::vector<const BladeStyle*>& styles) {
+    UseCounts uses;
+    for (const auto *style : styles) countUses(*style, uses);
+
+    AliasedStrings ret;
+    AliasMap aliases;
+    std::unordered_map<std::string_view, uint32_t> nameCounts;
+    for (const auto *style : styles) emitAliases(*style, uses, aliases, nameCounts, ret);
+
+    ret.styles.reserve(styles.size());
+    for (const auto *style : styles) ret.styles.push_back(toString(*style, &aliases));
+
+    return ret;
+}
+
+static void countUses(const BladeStyle& style, UseCounts& uses) {
+    for (const auto& param : style.getParams()) {
+        if (!(param.getType() & STYLETYPE) || !param.getStyle()) continue;
+        // Only descend the first time, a subtree's own uses don't multiply
+        if (++uses[param.getStyle()] == 1) countUses(*param.getStyle(), uses);
     }
-    style->comment = std::move(styleTokens->comment);
-
-    for (size_t i{0}; i < numTokenParams; i++) {
-        const auto *param{style->getParam(i < numParams ? i : numParams - 1)};
-        auto& tokenParam{styleTokens->params.at(i)};
-
-        int32_t val{0};
-        if (param->getType() & (NUMBER | BITS | BOOL)) {
-            if (tokenParam.paramStr.find("true") != std::string::npos) val = true;
-            else if (tokenParam.paramStr.find("false") != std::string::npos) val = false;
-            else {
-                char* stoiEnd{nullptr};
-                val = static_cast<int32_t>(std::strtol(tokenParam.paramStr.c_str(), &stoiEnd, 0));
-                if (val == 0 && *stoiEnd == 'b' && *(stoiEnd - 1) == '0') {
-                    val = static_cast<int32_t>(std::strtol(stoiEnd + 1, nullptr, 2));
-                }
-            }
-        }
-        switch (param->getType() & FLAGMASK) {
-            case NUMBER:
-                STYLECAST(NumberParam, param)->setNum(val);
-                break;
-            case BITS:
-                STYLECAST(BitsParam, param)->setBits(val);
-                break;
-            case BOOL:
-                STYLECAST(BoolParam, param)->setBool(val);
-                break;
-            default:
-                auto *paramStyle{parseString(tokenParam.rawStr, foundStyle)};
-                if (!paramStyle) {
-                    Logger::error("Failure while parsing parameter " + std::to_string(i + 1) + " in style " + styleTokens->name);
-                    delete style;
-                    return nullptr;
-                }
-                STYLECAST(StyleParam, param)->setStyle(paramStyle);
-                break;
-        }
+}
+
+static void emitAliases(
+        const BladeStyle& style,
+        const UseCounts& uses,
+        AliasMap& aliases,
+        std::unordered_map<std::string_view, uint32_t>& nameCounts,
+        AliasedStrings& out) {
+    auto hasStyleParams{false};
+    for (const auto& param : style.getParams()) {
+        if (!(param.getType() & STYLETYPE) || !param.getStyle()) continue;
+        hasStyleParams = true;
+
+        const auto *paramStyle{param.getStyle()};
+        if (aliases.contains(paramStyle)) continue;
+        emitAliases(*paramStyle, uses, aliases, nameCounts, out);
     }
 
-    return style;
+    // Aliasing a single Int<> or color doesn't make anything shorter,
+    // and a wrapper's only valid as the whole style.
+    if (!hasStyleParams || style.getType() & WRAPPER) return;
+    const auto useIt{uses.find(&style)};
+    if (useIt == uses.end() || useIt->second < 2) return;
+
+    // Left unaliased, so the styles using it fail to convert instead.
+    auto styleStr{toString(style, &aliases)};
+    if (!styleStr) return;
+
+    std::string name{style.osName};
+    name += '_';
+    name += std::to_string(++nameCounts[style.osName]);
+
+    out.aliases.emplace_back(name, std::move(*styleStr));
+    aliases.emplace(&style, std::move(name));
 }
 
-std::optional<std::string> BladeStyles::asString(const BladeStyle& style) {
+static std::optional<std::string> toString(const BladeStyle& style, const AliasMap* aliases) {
     std::string ret;
 
     if (!style.comment.empty()) {
@@ -138,9 +166,9 @@ std::optional<std::string> BladeStyles::asString(const BladeStyle& style) {
     }
 
     auto shouldIndentParams{false};
-    for (auto *const param : style.getParams()) {
-        if (param->getType() & STYLETYPE) {
-            if (static_cast<StyleParam*>(param)->getStyle()->getType() & FIXEDCOLOR) continue;
+    for (const auto& param : style.getParams()) {
+        if (param.getType() & STYLETYPE) {
+            if (param.getStyle()->getType() & FIXEDCOLOR) continue;
             shouldIndentParams = true;
             break;
         }
@@ -148,26 +176,33 @@ std::optional<std::string> BladeStyles::asString(const BladeStyle& style) {
 
     ret += style.osName;
     if (!(style.getType() & FIXEDCOLOR)) ret += '<';
-    for (auto *const param : style.getParams()) {
+    for (const auto& param : style.getParams()) {
         if (shouldIndentParams) ret += "\n\t";
-        switch (param->getType() & FLAGMASK) {
+        switch (param.getType() & FLAGMASK) {
             case NUMBER:
-                ret += std::to_string(static_cast<NumberParam*>(param)->getNum());
+                ret += std::to_string(param.getNum());
                 break;
             case BITS: {                
-                auto bits{static_cast<BitsParam*>(param)->getBits()};
+                auto bits{param.getBits()};
                 ret += "0b";
                 for (uint32_t i{0}; i < sizeof(uint16_t) * CHAR_BIT; i++) {
                     ret += ((bits >> i) & 0x1) ? '1' : '0';
                 }
                 break; }
             case BOOL:
-                ret += static_cast<BoolParam*>(param)->getBool() ? "true" : "false";
+                ret += param.getBool() ? "true" : "false";
                 break;
             default:
-                const auto *paramStyle{static_cast<StyleParam*>(param)->getStyle()};
+                const auto *paramStyle{param.getStyle()};
                 if (!paramStyle) return std::nullopt;
-                auto styleStr{asString(*paramStyle)};
+                if (aliases) {
+                    const auto aliasIt{aliases->find(paramStyle)};
+                    if (aliasIt != aliases->end()) {
+                        ret += aliasIt->second;
+                        break;
+                    }
+                }
+                auto styleStr{toString(*paramStyle, aliases)};
                 if (!styleStr) return std::nullopt;
                 if (shouldIndentParams) {
                     size_t newlinePos{0};
@@ -178,7 +213,7 @@ std::optional<std::string> BladeStyles::asString(const BladeStyle& style) {
                 ret += styleStr.value();
                 break;
         }
-        if (param != style.getParams().back()) ret += ", ";
+        if (&param != &style.getParams().back()) ret += ", ";
     }
     if (shouldIndentParams) ret += '\n'; 
     if (!(style.getType() & FIXEDCOLOR)) ret += '>';
@@ -187,155 +222,257 @@ std::optional<std::string> BladeStyles::asString(const BladeStyle& style) {
     return ret;
 }
 
-static std::optional<TokenizedStyle> tokenizeStyle(const std::string& styleStr) {
-    // Find all comments
-    std::vector<std::pair<size_t, size_t>> commentRanges;
-    size_t commentIndex{0};
-    while (!false) {
-        auto commentBegin{styleStr.find("/*", commentIndex)};
-        auto commentEnd{styleStr.find("*/", commentBegin)};
+static BladeStyle* parseStyle(StyleParser& parser) {
+    const auto firstComment{parser.nextComment};
+    skipIgnored(parser);
+    // BuiltIns are referenced by address
+    if (parser.peek() == '&') parser.pos++;
+
+    const auto endComment{parser.nextComment};
+    auto name{parseIdentifier(parser)};
+    if (name.empty()) {
+        Logger::error("Could not find style name/begin of style!");
+        return nullptr;
+    }
 
-        auto commentFound{commentBegin != std::string::npos || commentEnd != std::string::npos};
-        auto localCommentIndex{commentIndex};
+    if (parser.foundStyle) *parser.foundStyle = false;
 
-        if (commentFound) {
-            if (commentBegin == std::string::npos || commentEnd == std::string::npos) {
-                Logger::error("Mismatched block comment, aborting!");
-                return std::nullopt;
-            }
-            commentRanges.emplace_back(commentBegin, commentEnd + 2);
-            localCommentIndex = commentEnd + 2;
+    auto styleGen{get(name)};
+    if (!styleGen && parser.aliases) {
+        const auto aliasIt{parser.aliases->find(std::string{name})};
+        if (aliasIt != parser.aliases->end()) {
+            if (parser.foundStyle) *parser.foundStyle = true;
+            aliasIt->second->retain();
+            return aliasIt->second;
         }
+    }
+    if (!styleGen) {
+        Logger::error("Style not recognized: " + std::string{name});
+        return nullptr;
+    }
+    if (parser.foundStyle) *parser.foundStyle = true;
 
-        commentBegin = styleStr.find("//", commentIndex);
-        commentFound |= commentBegin != std::string::npos;
-        if (commentBegin != std::string::npos) {
-            commentEnd = styleStr.find('\n', commentBegin);
-            commentRanges.emplace_back(commentBegin, commentEnd + 1);
-
-            if (commentEnd > localCommentIndex) localCommentIndex = commentEnd;
+    auto *style{styleGen({})};
+    style->comment = getComments(parser, firstComment, endComment);
+
+    const auto numParams{style->getParams().size()};
+    const auto isVariadic{numParams > 0 && style->getParams().back().getType() & VARIADIC};
+    size_t numParsed{0};
+
+    skipIgnored(parser);
+    if (parser.peek() == '<') {
+        parser.pos++;
+        // Leave any comments in front of the first param for it to pick up
+        const auto paramsBegin{parser.pos};
+        const auto paramsComment{parser.nextComment};
+        skipIgnored(parser);
+        const auto hasParams{parser.peek() != '>'};
+        if (hasParams) {
+            parser.pos = paramsBegin;
+            parser.nextComment = paramsComment;
+        } else parser.pos++;
+
+        while (hasParams) {
+            if (numParsed >= numParams && !isVariadic) {
+                Logger::error("Incorrect number of parameters for style: " + 
+                        std::string{name} + 
+                        " (Expected " + 
+                        std::to_string(numParams) +
+                        " got more)");
+                BladeStyle::release(style);
+                return nullptr;
+            }
+            if (!parseParam(parser, *style, numParsed)) {
+                Logger::error("Failure while parsing parameter " + std::to_string(numParsed + 1) + " in style " + std::string{name});
+                BladeStyle::release(style);
+                return nullptr;
+            }
+            numParsed++;
+
+            skipIgnored(parser);
+            const auto delimiter{parser.peek()};
+            parser.pos++;
+            if (delimiter == ',') continue;
+            if (delimiter == '>') break;
+
+            if (delimiter == '\0') Logger::warn("Mismatched <> in style: " + std::string{name});
+            else Logger::warn("Error parsing arguments for style: " + std::string{name});
+            BladeStyle::release(style);
+            return nullptr;
         }
 
-        commentIndex = localCommentIndex;
-        if (!commentFound) break;
-    }
-    std::sort(commentRanges.begin(), commentRanges.end());
-
-    TokenizedStyle styleTokens;
-
-    // Find name
-    size_t nameEnd{0};
-    for (size_t i{0}; i < styleStr.length(); i++) {
-        // Jump over commentRanges
-        bool jumped{false};
-        for (const auto& [ cBegin, cEnd ] : commentRanges) {
-            if (i == cBegin) {
-                i = cEnd - 1; // compensate for i++ in loop
-                jumped = true;
-                break;
+        // Wrappers are "called"
+        skipIgnored(parser);
+        if (parser.peek() == '(') {
+            parser.pos++;
+            skipIgnored(parser);
+            if (parser.peek() != ')') {
+                Logger::warn("Mismatched () in style: " + std::string{name});
+                BladeStyle::release(style);
+                return nullptr;
             }
+            parser.pos++;
         }
-        if (jumped) continue;
+    }
 
-        char characer{styleStr.at(i)};
+    if (numParsed < numParams) {
+        Logger::error("Incorrect number of parameters for style: " + 
+                std::string{name} + 
+                " (Expected " + 
+                std::to_string(numParams) +
+                " got " + 
+                std::to_string(numParsed) +
+                ")");
+        BladeStyle::release(style);
+        return nullptr;
+    }
 
-        if (std::isalpha(characer) != 0) {
-            auto nameBegin{i};
-            while (i < styleStr.length() && std::isalnum(styleStr.at(i))) { i++; }
-            styleTokens.name = styleStr.substr(nameBegin, i - nameBegin);
-            nameEnd = i;
-            break;
-        }
+    return style;
+}
+
+static bool parseParam(StyleParser& parser, BladeStyle& style, size_t idx) {
+    const auto numParams{style.getParams().size()};
+    const auto *param{style.getParam(idx < numParams ? idx : numParams - 1)};
+
+    if (param->getType() & (NUMBER | BITS | BOOL)) {
+        auto val{parseScalar(parser)};
+        if (!val) return false;
+        if (idx >= numParams) return style.addParam(*val);
+        return style.setParam(idx, *val);
     }
 
-    if (styleTokens.name.empty()) {
-        Logger::error("Could not find style name/begin of style!");
+    auto *paramStyle{parseStyle(parser)};
+    if (!paramStyle) return false;
+
+    if (idx >= numParams ? style.addParam(paramStyle) : style.setParam(idx, paramStyle)) return true;
+    BladeStyle::release(paramStyle);
+    return false;
+}
+
+static std::string_view parseIdentifier(StyleParser& parser) {
+    const auto isIdentChar{[](char chr) { return std::isalnum(static_cast<unsigned char>(chr)) || chr == '_'; }};
+
+    const auto begin{parser.pos};
+    if (std::isdigit(static_cast<unsigned char>(parser.peek())) || !isIdentChar(parser.peek())) return {};
+    while (!parser.atEnd() && isIdentChar(parser.peek())) parser.pos++;
+
+    return parser.str.substr(begin, parser.pos - begin);
+}
+
+static std::optional<int32_t> parseScalar(StyleParser& parser) {
+    skipIgnored(parser);
+
+    const auto begin{parser.pos};
+    while (!parser.atEnd()) {
+        const auto chr{parser.peek()};
+        if (!std::isalnum(static_cast<unsigned char>(chr)) && chr != '_' && chr != '-' && chr != '+') break;
+        parser.pos++;
+    }
+    auto token{parser.str.substr(begin, parser.pos - begin)};
+
+    if (token == "true") return true;
+    if (token == "false") return false;
+
+    auto negative{false};
+    if (!token.empty() && (token.front() == '-' || token.front() == '+')) {
+        negative = token.front() == '-';
+        token.remove_prefix(1);
+    }
+
+    int32_t base{10};
+    if (token.length() > 2 && token[0] == '0' && (token[1] == 'x' || token[1] == 'X')) {
+        base = 16;
+        token.remove_prefix(2);
+    } else if (token.length() > 2 && token[0] == '0' && (token[1] == 'b' || token[1] == 'B')) {
+        base = 2;
+        token.remove_prefix(2);
+    } else if (token.length() > 1 && token[0] == '0') {
+        base = 8;
+        token.remove_prefix(1);
+    }
+
+    int64_t val{0};
+    const auto *tokenEnd{token.data() + token.length()};
+    auto [ parseEnd, err ]{std::from_chars(token.data(), tokenEnd, val, base)};
+    if (token.empty() || err != std::errc{} || parseEnd != tokenEnd) {
+        Logger::error("Invalid number: \"" + std::string(parser.str.substr(begin, parser.pos - begin)) + '"');
         return std::nullopt;
     }
-    auto getCommentsInRange{[&commentRanges, &styleStr](size_t begin, size_t end) -> std::string {
-        std::string ret;
-        for (const auto& [ cmntBegin, cmntEnd ] : commentRanges) {
-            if (cmntEnd < begin) continue;
-            if (cmntBegin > end) break;
-
-            if (!ret.empty()) ret += '\n';
-            if (styleStr.at(cmntEnd - 1) == '/') { // is a block comment
-                auto contentBegin{std::find_if_not(std::next(styleStr.cbegin(), static_cast<int64_t>(cmntBegin + 2)), std::next(styleStr.cbegin(), static_cast<int64_t>(cmntEnd - 3)), isspace)};
-                // ***backwards*** lol
-                auto contentEnd{std::find_if_not(std::prev(styleStr.crend(), static_cast<int64_t>(cmntEnd - 2)), std::prev(styleStr.crend(), static_cast<int64_t>(cmntBegin + 2)), isspace)};
-                const char *subCStr{contentBegin.base()};
-                auto length{contentEnd.base() - contentBegin};
-                ret += std::string(subCStr, length);
-            } else { // is a line comment
-                ret += styleStr.substr(cmntBegin + 2, cmntEnd - cmntBegin - 3);
-            }
+
+    return static_cast<int32_t>(negative ? -val : val);
+}
+
+static void skipIgnored(StyleParser& parser) {
+    const auto& commentRanges{parser.commentRanges};
+    while (parser.nextComment < commentRanges.size() && commentRanges[parser.nextComment].second <= parser.pos) {
+        parser.nextComment++;
+    }
+
+    while (!parser.atEnd()) {
+        if (parser.nextComment < commentRanges.size() && commentRanges[parser.nextComment].first == parser.pos) {
+            parser.pos = commentRanges[parser.nextComment].second;
+            parser.nextComment++;
+            continue;
         }
-        return ret;
-    }};
-    styleTokens.comment = getCommentsInRange(0, nameEnd);
-
-    if (nameEnd > styleStr.length()) return styleTokens;
-
-    auto paramSubStr{styleStr.substr(nameEnd)};
-    size_t paramBegin{1}; // Skip over the < at nameEnd
-    size_t paramNameEnd{std::string::npos};
-    std::string buf;
-    int32_t depth{0};
-    char character{'\0'};
-    for (size_t i = 0; i < paramSubStr.size(); i++) {
-        // Jump over commentRanges
-        for (const auto& [ cBegin, cEnd ] : commentRanges) {
-            if (i + nameEnd == cBegin) i = cEnd - nameEnd;
+
+        if (!std::isspace(static_cast<unsigned char>(parser.peek()))) break;
+        parser.pos++;
+    }
+}
+
+static bool findComments(StyleParser& parser) {
+    const auto& styleStr{parser.str};
+
+    size_t idx{0};
+    while (idx + 1 < styleStr.length()) {
+        if (styleStr[idx] != '/') {
+            idx++;
+            continue;
         }
 
-        character = paramSubStr.at(i);
-        if (character == ' ') continue;
-        if (character == '\n') continue;
-        if (character == '\t') continue;
-        if (character == '\r') continue;
-
-        if (character == '<') {
-            if (depth == 1 && paramNameEnd == std::string::npos) {
-                paramNameEnd = i;
-            } else if (depth == 0) {
-                buf.clear();
-                depth++;
-                continue;
-            }
-            depth++;
-        } else if (character == '>') {
-            depth--;
-            if (depth < 0) {
-                Logger::warn("Error parsing arguments for style: " + styleTokens.name);
-                return std::nullopt;
-            }
-            if (depth == 0) {
-                styleTokens.params.push_back({
-                        .rawStr = paramSubStr.substr(paramBegin, i - paramBegin),
-                        .paramStr = buf,
-                        .comments = getCommentsInRange(paramBegin + nameEnd, paramNameEnd + nameEnd),
-                        });
-                break;
+        size_t commentEnd{0};
+        if (styleStr[idx + 1] == '*') {
+            commentEnd = styleStr.find("*/", idx + 2);
+            if (commentEnd == std::string_view::npos) {
+                Logger::error("Mismatched block comment, aborting!");
+                return false;
             }
-        } else if (character == ',' && depth == 1) {
-            styleTokens.params.push_back({
-                    .rawStr = paramSubStr.substr(paramBegin, i - paramBegin),
-                    .paramStr = buf,
-                    .comments = getCommentsInRange(paramBegin + nameEnd, paramNameEnd + nameEnd),
-                    });
-            buf.clear();
-            paramBegin = i + 1;
+            commentEnd += 2;
+        } else if (styleStr[idx + 1] == '/') {
+            commentEnd = styleStr.find('\n', idx + 2);
+            commentEnd = commentEnd == std::string_view::npos ? styleStr.length() : commentEnd + 1;
+        } else {
+            idx++;
             continue;
         }
 
-        buf += character;
-    }
-    if (depth != 0) {
-        Logger::warn("Mismatched <> in style: " + styleTokens.name);
-        return std::nullopt;
+        parser.commentRanges.emplace_back(idx, commentEnd);
+        idx = commentEnd;
     }
 
-    return styleTokens;
+    return true;
+}
+
+static std::string getComments(const StyleParser& parser, size_t firstComment, size_t endComment) {
+    const auto isSpace{[](char chr) { return std::isspace(static_cast<unsigned char>(chr)) != 0; }};
+
+    std::string ret;
+    for (auto idx{firstComment}; idx < endComment; idx++) {
+        const auto& [ cmntBegin, cmntEnd ]{parser.commentRanges[idx]};
+
+        std::string_view content;
+        if (parser.str[cmntEnd - 1] == '/') { // is a block comment
+            content = parser.str.substr(cmntBegin + 2, cmntEnd - cmntBegin - 4);
+        } else { // is a line comment
+            content = parser.str.substr(cmntBegin + 2, cmntEnd - cmntBegin - 2);
+        }
+        while (!content.empty() && isSpace(content.front())) content.remove_prefix(1);
+        while (!content.empty() && isSpace(content.back())) content.remove_suffix(1);
+
+        if (!ret.empty()) ret += '\n';
+        ret += content;
+    }
+    return ret;
 }
 
 static std::string typeToString(uint32_t type) {
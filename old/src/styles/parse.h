@@ -21,13 +21,48 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 
 #include "bladestyle.h"
 
 namespace BladeStyles {
 
-BladeStyle* parseString(const std::string&, bool* foundStyle = nullptr);
+/**
+ * Alias names and the (shared) styles they stand for.
+ */
+using StyleAliases = std::unordered_map<std::string, BladeStyle*>;
+
+/**
+ * @param aliases if given, names in it are accepted as styles, and parse
+ * to a new reference to the aliased style.
+ */
+BladeStyle* parseString(std::string_view, bool* foundStyle = nullptr, const StyleAliases* aliases = nullptr);
 std::optional<std::string> asString(const BladeStyle&);
 
+struct AliasedStrings {
+    /**
+     * Alias name and the style it stands for, each only referring to
+     * ones before it.
+     */
+    std::vector<std::pair<std::string, std::string>> aliases;
+    /**
+     * The styles given, in the same order, referring to the aliases.
+     * std::nullopt for any that couldn't be converted.
+     */
+    std::vector<std::optional<std::string>> styles;
+};
+/**
+ * Convert styles to strings, with every subtree that's used more than once
+ * pulled out into an alias to cut down on output size.
+ *
+ * Subtrees are matched by address, so styles should be interned first
+ * (see InternTable). Wrappers are never aliased, since they're only
+ * valid as a whole preset style.
+ */
+AliasedStrings asAliasedStrings(const std::vector<const BladeStyle*>& styles);
+
 } // namespace BladeStyles
@@ -0,0 +1,111 @@
+#include "stylepool.h"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * styles/stylepool.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+using namespace BladeStyles;
+
+namespace {
+
+// Covers style elements, anything larger goes straight to the heap.
+constexpr size_t MAX_POOLED_SIZE{1024};
+constexpr size_t NUM_SIZE_CLASSES{MAX_POOLED_SIZE / StylePool::ALIGNMENT};
+constexpr size_t SLAB_SIZE{64 * 1024};
+
+static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ >= StylePool::ALIGNMENT);
+
+struct FreeNode {
+    FreeNode* next;
+};
+
+struct Pool {
+    std::mutex lock;
+    std::array<FreeNode*, NUM_SIZE_CLASSES> freeLists{};
+
+    std::vector<std::unique_ptr<std::byte[]>> slabs;
+    std::byte* slabPos{nullptr};
+    size_t slabRemaining{0};
+};
+
+} // namespace
+
+static Pool& getPool();
+static size_t getSizeClass(size_t size);
+
+void* StylePool::allocate(size_t size) {
+    if (size > MAX_POOLED_SIZE) return ::operator new(size);
+
+    const auto sizeClass{getSizeClass(size)};
+    const auto slotSize{(sizeClass + 1) * ALIGNMENT};
+
+    auto& pool{getPool()};
+    std::lock_guard lock{pool.lock};
+
+    auto*& freeList{pool.freeLists[sizeClass]};
+    if (freeList) {
+        auto *ret{freeList};
+        freeList = ret->next;
+        return ret;
+    }
+
+    // Whatever's left of the old slab is abandoned, it's never more than
+    // MAX_POOLED_SIZE.
+    if (pool.slabRemaining < slotSize) {
+        pool.slabs.push_back(std::make_unique_for_overwrite<std::byte[]>(SLAB_SIZE));
+        pool.slabPos = pool.slabs.back().get();
+        pool.slabRemaining = SLAB_SIZE;
+    }
+
+    auto *ret{pool.slabPos};
+    pool.slabPos += slotSize;
+    pool.slabRemaining -= slotSize;
+    return ret;
+}
+
+void StylePool::deallocate(void* ptr, size_t size) {
+    if (!ptr) return;
+    if (size > MAX_POOLED_SIZE) {
+        ::operator delete(ptr, size);
+        return;
+    }
+
+    auto& pool{getPool()};
+    std::lock_guard lock{pool.lock};
+
+    auto*& freeList{pool.freeLists[getSizeClass(size)]};
+    freeList = new (ptr) FreeNode{freeList};
+}
+
+static Pool& getPool() {
+    // Intentionally leaked, styles held by statics could otherwise be
+    // freed into a pool that's already been destroyed.
+    static auto *pool{new Pool};
+    return *pool;
+}
+
+static size_t getSizeClass(size_t size) {
+    return size == 0 ? 0 : (size - 1) / StylePool::ALIGNMENT;
+}
+
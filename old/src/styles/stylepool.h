@@ -0,0 +1,46 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * styles/stylepool.h
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstddef>
+
+/**
+ * Allocator for style nodes.
+ *
+ * Nodes are carved out of large slabs by size class and recycled through
+ * per-class free lists, so a style tree sits in a few contiguous blocks
+ * instead of being scattered across the heap. Slabs are kept for reuse
+ * rather than returned.
+ *
+ * Safe to use from any thread.
+ */
+namespace BladeStyles::StylePool {
+
+/**
+ * Allocations are aligned to this, anything needing more must not come
+ * from the pool.
+ */
+constexpr size_t ALIGNMENT{16};
+
+[[nodiscard]] void* allocate(size_t size);
+void deallocate(void* ptr, size_t size);
+
+} // namespace BladeStyles::StylePool
+
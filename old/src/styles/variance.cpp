@@ -0,0 +1,63 @@
+#include "variance.h"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * styles/variance.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include "styles/bladestyle.h"
+#include "styles/elements/functions.h"
+
+using namespace BladeStyles;
+
+static Variance analyze(const BladeStyle* style, VarianceMap& map);
+
+VarianceMap BladeStyles::analyzeVariance(const BladeStyle* style) {
+    VarianceMap map;
+    if (style) analyze(style, map);
+    return map;
+}
+
+static Variance analyze(const BladeStyle* style, VarianceMap& map) {
+    // Params have to be classified regardless, so do them first
+    auto paramVariance{Variance::CONSTANT};
+    for (const auto& param : style->getParams()) {
+        if (!(param.getType() & STYLETYPE)) continue;
+        const auto* paramStyle{param.getStyle()};
+        if (!paramStyle) continue;
+        paramVariance = std::max(paramVariance, analyze(paramStyle, map));
+    }
+
+    const auto type{style->getType()};
+    Variance variance;
+    if (type & FUNCTION) {
+        variance = static_cast<const FunctionStyle*>(style)->getVariance();
+        if (variance == Variance::CONSTANT) variance = paramVariance;
+    } else if (type & WRAPPER) {
+        variance = paramVariance;
+    } else if (type & FIXEDCOLOR || type & (EFFECT | LOCKUPTYPE | ARGUMENT)) {
+        variance = Variance::CONSTANT;
+    } else {
+        variance = Variance::PER_LED;
+    }
+
+    map[style] = variance;
+    return variance;
+}
+
@@ -0,0 +1,53 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * styles/variance.h
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace BladeStyles {
+
+class BladeStyle;
+
+/**
+ * How often a style's value can change, ordered from least to most.
+ */
+enum class Variance : uint8_t {
+    // Same value forever
+    CONSTANT,
+    // Same value for every LED in a frame (SVF)
+    PER_FRAME,
+    // Different value for each LED
+    PER_LED,
+};
+
+using VarianceMap = std::unordered_map<const BladeStyle*, Variance>;
+
+/**
+ * Classify style and every style below it.
+ *
+ * Functions report their own variance, everything else is judged by type:
+ * fixed colors and params like effects are CONSTANT, wrappers are whatever
+ * they wrap, and the rest is PER_LED.
+ */
+[[nodiscard]] VarianceMap analyzeVariance(const BladeStyle* style);
+
+} // namespace BladeStyles
+
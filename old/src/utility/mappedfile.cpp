@@ -0,0 +1,104 @@
+#include "mappedfile.h"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * utility/mappedfile.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef __WXMSW__
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+#ifdef __WXMSW__
+
+Utility::MappedFile::MappedFile(const std::string& filename) {
+    mFileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (mFileHandle == INVALID_HANDLE_VALUE) {
+        mFileHandle = nullptr;
+        return;
+    }
+
+    LARGE_INTEGER fileSize;
+    FILETIME writeTime;
+    if (!GetFileSizeEx(mFileHandle, &fileSize) || !GetFileTime(mFileHandle, nullptr, nullptr, &writeTime)) return;
+    mSize = static_cast<size_t>(fileSize.QuadPart);
+    mModifiedTime = static_cast<int64_t>((static_cast<uint64_t>(writeTime.dwHighDateTime) << 32) | writeTime.dwLowDateTime);
+
+    // Empty files can't be mapped, but are still valid to read.
+    if (mSize == 0) {
+        mOpen = true;
+        return;
+    }
+
+    mMapHandle = CreateFileMappingA(mFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mMapHandle) return;
+
+    mData = static_cast<const char*>(MapViewOfFile(mMapHandle, FILE_MAP_READ, 0, 0, 0));
+    mOpen = mData != nullptr;
+}
+
+Utility::MappedFile::~MappedFile() {
+    if (mData) UnmapViewOfFile(mData);
+    if (mMapHandle) CloseHandle(mMapHandle);
+    if (mFileHandle) CloseHandle(mFileHandle);
+}
+
+#else
+
+Utility::MappedFile::MappedFile(const std::string& filename) {
+    const auto fileDescriptor{::open(filename.c_str(), O_RDONLY)};
+    if (fileDescriptor < 0) return;
+
+    struct stat fileStat{};
+    if (fstat(fileDescriptor, &fileStat) != 0) {
+        close(fileDescriptor);
+        return;
+    }
+    mSize = static_cast<size_t>(fileStat.st_size);
+#   ifdef __APPLE__
+    mModifiedTime = (static_cast<int64_t>(fileStat.st_mtimespec.tv_sec) * 1000000000) + fileStat.st_mtimespec.tv_nsec;
+#   else
+    mModifiedTime = (static_cast<int64_t>(fileStat.st_mtim.tv_sec) * 1000000000) + fileStat.st_mtim.tv_nsec;
+#   endif
+
+    // Empty files can't be mapped, but are still valid to read.
+    if (mSize == 0) {
+        close(fileDescriptor);
+        mOpen = true;
+        return;
+    }
+
+    auto *mapping{mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0)};
+    // The mapping holds its own reference to the file.
+    close(fileDescriptor);
+    if (mapping == MAP_FAILED) return;
+
+    mData = static_cast<const char*>(mapping);
+    mOpen = true;
+}
+
+Utility::MappedFile::~MappedFile() {
+    if (mData) munmap(const_cast<char*>(mData), mSize);
+}
+
+#endif
+
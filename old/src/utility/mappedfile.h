@@ -0,0 +1,60 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * utility/mappedfile.h
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace Utility {
+
+/**
+ * Read-only memory mapping of an entire file.
+ *
+ * The mapping is released when the MappedFile is destroyed, so any views
+ * into data() must not outlive it.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filename);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+    ~MappedFile();
+
+    [[nodiscard]] bool isOpen() const { return mOpen; }
+    [[nodiscard]] std::span<const char> data() const { return { mData, mSize }; }
+    [[nodiscard]] int64_t modifiedTime() const { return mModifiedTime; }
+
+private:
+    bool mOpen{false};
+    const char* mData{nullptr};
+    size_t mSize{0};
+    int64_t mModifiedTime{0};
+
+#   ifdef __WXMSW__
+    void* mFileHandle{nullptr};
+    void* mMapHandle{nullptr};
+#   endif
+};
+
+} // namespace Utility
+
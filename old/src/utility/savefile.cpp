@@ -0,0 +1,48 @@
+#include "savefile.h"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * utility/savefile.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+bool Utility::saveFile(const std::string& filename, std::string_view contents) {
+    const auto tempFilename{filename + ".tmp"};
+    {
+        std::ofstream outFile{tempFilename, std::ios::binary | std::ios::trunc};
+        if (!outFile.is_open()) return false;
+
+        outFile.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        outFile.close();
+        if (outFile.fail()) {
+            std::remove(tempFilename.c_str());
+            return false;
+        }
+    }
+
+    std::error_code err;
+    std::filesystem::rename(tempFilename, filename, err);
+    if (err) {
+        std::remove(tempFilename.c_str());
+        return false;
+    }
+
+    return true;
+}
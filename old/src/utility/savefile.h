@@ -1,9 +1,9 @@
-#include "utilfuncs.h"
+#pragma once
 /*
  * ProffieConfig, All-In-One Proffieboard Management Utility
  * Copyright (C) 2024 Ryan Ogurek
  *
- * proffieconstructs/utilfuncs.cpp
+ * utility/savefile.h
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -19,15 +19,19 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <cstdint>
-#include <random>
+#include <string>
+#include <string_view>
 
-namespace ProffieUtils {
+namespace Utility {
 
-uint32_t random() {
-    static std::minstd_rand generator;
-    static std::uniform_int_distribution<uint32_t> distribution;
-    return distribution(generator);
-}
+/**
+ * Replace filename with contents, writing to filename + ".tmp" first and
+ * renaming it over, so a failed or interrupted save never leaves a
+ * truncated file behind.
+ *
+ * @return false if the file couldn't be written, in which case the
+ * original (if any) is left untouched
+ */
+[[nodiscard]] bool saveFile(const std::string& filename, std::string_view contents);
 
-} // namespace ProffieUtils
+} // namespace Utility
@@ -0,0 +1,74 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2024 Ryan Ogurek
+ *
+ * utility/spscqueue.h
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+
+namespace Utility {
+
+/**
+ * Fixed-capacity, lock-free queue for exactly one producer thread and one
+ * consumer thread.
+ */
+template<typename T, size_t CAPACITY>
+class SPSCQueue {
+public:
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    /**
+     * Producer only
+     *
+     * @return false if the queue was full and value was dropped
+     */
+    bool push(const T& value) {
+        const auto tail{mTail.load(std::memory_order_relaxed)};
+        if (tail - mHead.load(std::memory_order_acquire) == CAPACITY) return false;
+
+        mBuffer[tail & (CAPACITY - 1)] = value;
+        mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer only
+     */
+    std::optional<T> pop() {
+        const auto head{mHead.load(std::memory_order_relaxed)};
+        if (head == mTail.load(std::memory_order_acquire)) return std::nullopt;
+
+        T value{mBuffer[head & (CAPACITY - 1)]};
+        mHead.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+private:
+    std::array<T, CAPACITY> mBuffer{};
+    // Kept on separate cache lines so the two threads don't contend
+    alignas(64) std::atomic<size_t> mHead{0};
+    alignas(64) std::atomic<size_t> mTail{0};
+};
+
+} // namespace Utility
+